@@ -0,0 +1,229 @@
+#include "kl/binary_rw.hpp"
+#include "kl/binary_rw/delta.hpp"
+#include "kl/binary_rw/endian.hpp"
+#include "kl/binary_rw/frame.hpp"
+#include "kl/binary_rw/variant.hpp"
+#include "kl/binary_rw/vector.hpp"
+
+#include <boost/endian/arithmetic.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/benchmark/catch_chronometer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+template <typename T>
+std::vector<T> make_samples(std::size_t count)
+{
+    std::vector<T> ret(count);
+    for (std::size_t i = 0; i < ret.size(); ++i)
+        ret[i] = static_cast<T>(i * 2654435761U);
+    return ret;
+}
+
+template <typename T, typename BigT>
+void run_endian_benchmarks(std::string_view name, std::size_t count)
+{
+    using Catch::Benchmark::Chronometer;
+    using boost::endian::order;
+
+    const auto samples = make_samples<T>(count);
+
+    kl::growable_binary_writer w{count * sizeof(T)};
+    REQUIRE(kl::write_endian_span<order::big>(w, gsl::span<const T>{samples}));
+    const auto encoded = w.release();
+
+    std::vector<T> decoded(count);
+
+    BENCHMARK_ADVANCED(std::string{"element by element read/"} + std::string{name})(
+        Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_reader r{encoded};
+            for (auto& value : decoded)
+                value = r.read<BigT>();
+            return r.err();
+        });
+    };
+
+    BENCHMARK_ADVANCED(std::string{"kl::read_endian_span/"} + std::string{name})(
+        Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_reader r{encoded};
+            return kl::read_endian_span<order::big>(r, gsl::span<T>{decoded});
+        });
+    };
+
+    REQUIRE(decoded == samples);
+
+    std::vector<std::byte> buffer(encoded.size());
+
+    BENCHMARK_ADVANCED(std::string{"element by element write/"} + std::string{name})(
+        Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_writer w{buffer};
+            for (const auto value : samples)
+                w << BigT{value};
+            return w.err();
+        });
+    };
+
+    BENCHMARK_ADVANCED(std::string{"kl::write_endian_span/"} + std::string{name})(
+        Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_writer w{buffer};
+            return kl::write_endian_span<order::big>(w, gsl::span<const T>{samples});
+        });
+    };
+}
+
+template <std::size_t I>
+struct message
+{
+    std::uint32_t value;
+};
+
+template <std::size_t I>
+void write_binary(kl::binary_writer& w, const message<I>& msg)
+{
+    w << msg.value;
+}
+
+template <std::size_t I>
+void read_binary(kl::binary_reader& r, message<I>& msg)
+{
+    r >> msg.value;
+}
+
+template <std::size_t... Is>
+std::variant<message<Is>...> make_message_variant(std::index_sequence<Is...>);
+
+template <std::size_t N>
+using message_variant = decltype(make_message_variant(std::make_index_sequence<N>{}));
+
+template <std::size_t N>
+void run_variant_benchmarks(std::string_view name, std::size_t index)
+{
+    using Catch::Benchmark::Chronometer;
+
+    constexpr std::size_t count = 4096;
+
+    kl::growable_binary_writer w;
+    for (std::size_t i = 0; i < count; ++i)
+        w << static_cast<std::uint8_t>(index) << static_cast<std::uint32_t>(i);
+    const auto encoded = w.release();
+
+    std::vector<message_variant<N>> decoded(count);
+
+    BENCHMARK_ADVANCED(std::string{"kl::read_variants/"} + std::string{name})(
+        Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_reader r{encoded};
+            return kl::read_variants(r, gsl::span<message_variant<N>>{decoded});
+        });
+    };
+
+    REQUIRE(decoded.back().index() == index);
+}
+} // namespace
+
+TEST_CASE("binary_rw endian bench")
+{
+    run_endian_benchmarks<std::int16_t, boost::endian::big_int16_t>("int16 x 1M", 1U << 20);
+    run_endian_benchmarks<std::uint32_t, boost::endian::big_uint32_t>("uint32 x 1M", 1U << 20);
+    run_endian_benchmarks<std::uint64_t, boost::endian::big_uint64_t>("uint64 x 1M", 1U << 20);
+}
+
+TEST_CASE("binary_rw variant bench")
+{
+    // Decoding cost shouldn't depend on which alternative is stored
+    run_variant_benchmarks<3>("3 alternatives, first", 0);
+    run_variant_benchmarks<3>("3 alternatives, last", 2);
+    run_variant_benchmarks<40>("40 alternatives, first", 0);
+    run_variant_benchmarks<40>("40 alternatives, last", 39);
+}
+
+TEST_CASE("binary_rw frame bench")
+{
+    const auto samples = make_samples<std::uint64_t>(1U << 17);
+    const auto bytes = gsl::as_bytes(gsl::span<const std::uint64_t>{samples});
+
+    BENCHMARK("kl::crc32c/1 MiB")
+    {
+        return kl::crc32c(bytes);
+    };
+
+    kl::growable_binary_writer w{bytes.size() + 64 * kl::frame_header_size};
+    BENCHMARK_ADVANCED("kl::write_frame/64 x 16 KiB")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure([&] {
+            w.clear();
+            for (std::size_t i = 0; i < 64; ++i)
+                kl::write_frame(w, bytes.subspan(i * 16384, 16384));
+            return w.pos();
+        });
+    };
+}
+
+TEST_CASE("binary_rw delta bench")
+{
+    using Catch::Benchmark::Chronometer;
+
+    // Tick timestamps in nanoseconds, a few microseconds apart
+    std::vector<std::int64_t> timestamps(1U << 20);
+    std::int64_t now = 1'700'000'000'000'000'000;
+    for (std::size_t i = 0; i < timestamps.size(); ++i)
+        timestamps[i] = now += static_cast<std::int64_t>(1000 + i * 2654435761U % 4000);
+
+    kl::growable_binary_writer plain;
+    plain << timestamps;
+    const auto plain_bytes = plain.release();
+
+    kl::growable_binary_writer delta;
+    kl::write_delta_encoded(delta, gsl::span<const std::int64_t>{timestamps});
+    const auto delta_bytes = delta.release();
+
+    WARN("plain: " << plain_bytes.size() << " bytes, delta: " << delta_bytes.size() << " bytes");
+
+    std::vector<std::int64_t> decoded;
+
+    BENCHMARK_ADVANCED("std::vector<int64_t> read/1M timestamps")(Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_reader r{plain_bytes};
+            r >> decoded;
+            return r.err();
+        });
+    };
+
+    BENCHMARK_ADVANCED("kl::read_delta_encoded/1M timestamps")(Chronometer meter)
+    {
+        meter.measure([&] {
+            kl::binary_reader r{delta_bytes};
+            return kl::read_delta_encoded(r, decoded);
+        });
+    };
+
+    REQUIRE(decoded == timestamps);
+
+    BENCHMARK_ADVANCED("kl::write_delta_encoded/1M timestamps")(Chronometer meter)
+    {
+        meter.measure([&] {
+            delta.clear();
+            return kl::write_delta_encoded(delta, gsl::span<const std::int64_t>{timestamps});
+        });
+    };
+}
@@ -3,6 +3,7 @@
 #include "kl/reflect_enum.hpp"
 #include "kl/reflect_struct.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <string>
@@ -47,3 +48,21 @@ struct test_t
     inner_t inner;
 };
 KL_REFLECT_STRUCT(test_t, hello, t, f, n, i, pi, a, ad, space, tup, map, inner)
+
+// Float-dense counterpart of test_t
+struct telemetry_t
+{
+    std::int64_t timestamp = 1700000000123;
+    double latitude = 52.229676;
+    double longitude = 21.012229;
+    double altitude = 112.5;
+    float temperature = 21.37f;
+    float humidity = 48.2f;
+    std::vector<double> samples = {0.001953125,   -17.25, 3.14159265358979,
+                                   2.718281828,   1e-7,   6.02214076e23,
+                                   -0.3333333333, 1024.0, 98.6};
+    std::vector<float> accel = {0.01f, -9.81f, 0.35f};
+    unsigned sequence = 4096;
+};
+KL_REFLECT_STRUCT(telemetry_t, timestamp, latitude, longitude, altitude, temperature, humidity,
+                  samples, accel, sequence)
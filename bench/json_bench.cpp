@@ -1,4 +1,6 @@
 #include "kl/json.hpp"
+#include "kl/json_lines.hpp"
+#include "kl/serialization_projection.hpp"
 #include "input/typedefs.hpp"
 
 #include <catch2/catch_test_macros.hpp>
@@ -9,8 +11,41 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <cstdlib>
+#include <new>
 #include <vector>
 
+// Counts heap allocations made through operator new by the current thread, to
+// check that warmed up json::arena cycles don't allocate. rapidjson allocates
+// with std::malloc instead, which is covered by arena.capacity() staying put.
+static thread_local std::size_t num_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++num_allocations;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+template <typename Fn>
+static std::size_t count_allocations(Fn&& fn)
+{
+    const auto before = num_allocations;
+    fn();
+    return num_allocations - before;
+}
+
 static std::string to_string(const rapidjson::Value& v)
 {
     rapidjson::StringBuffer buffer;
@@ -133,4 +168,208 @@ TEST_CASE("json bench")
             input.emplace_back();
         meter.measure([&] { return json::dump(input); });
     };
+
+    BENCHMARK_ADVANCED("json::dump (small records)")(Chronometer meter)
+    {
+        const std::vector<inner_t> input(100 * num_objects);
+        meter.measure([&] { return json::dump(input); });
+    };
+
+    BENCHMARK_ADVANCED("json::dump (floats, rapidjson::Writer)")(Chronometer meter)
+    {
+        const std::vector<telemetry_t> input(10 * num_objects);
+        meter.measure([&] { return json::dump(input); });
+    };
+
+    BENCHMARK_ADVANCED("json::dump (floats, json::string_writer)")(Chronometer meter)
+    {
+        const std::vector<telemetry_t> input(10 * num_objects);
+        meter.measure([&] {
+            json::string_writer writer;
+            json::dump_context ctx{writer};
+            json::dump(input, ctx);
+            return writer.release();
+        });
+    };
+
+    BENCHMARK_ADVANCED("json::dump (json::string_writer)")(Chronometer meter)
+    {
+        std::vector<test_t> input;
+        for (int i = 0; i < num_objects; ++i)
+            input.emplace_back();
+        meter.measure([&] {
+            json::string_writer writer;
+            json::dump_context ctx{writer};
+            json::dump(input, ctx);
+            return writer.release();
+        });
+    };
+
+    BENCHMARK_ADVANCED("json::parse + json::deserialize")(Chronometer meter)
+    {
+        const auto text = json::dump(std::vector<test_t>(num_objects));
+        meter.measure(
+            [&] { return json::deserialize<std::vector<test_t>>(json::parse(text)); });
+    };
+
+    BENCHMARK_ADVANCED("json::deserialize (large array)")(Chronometer meter)
+    {
+        const auto doc = json::serialize(std::vector<test_t>(100 * num_objects));
+        meter.measure([&] { return json::deserialize<std::vector<test_t>>(doc); });
+    };
+
+    BENCHMARK_ADVANCED("json::deserialize (large array, parallel)")(Chronometer meter)
+    {
+        const auto doc = json::serialize(std::vector<test_t>(100 * num_objects));
+        json::parallel_deserialize_context ctx;
+        meter.measure([&] { return json::deserialize<std::vector<test_t>>(doc, ctx); });
+    };
+
+    BENCHMARK_ADVANCED("json::load")(Chronometer meter)
+    {
+        const auto text = json::dump(std::vector<test_t>(num_objects));
+        meter.measure([&] { return json::load<std::vector<test_t>>(text); });
+    };
+
+    BENCHMARK_ADVANCED("json::load (projection)")(Chronometer meter)
+    {
+        using test_header_t = serialization::projection<test_t, &test_t::hello, &test_t::i>;
+        const auto text = json::dump(std::vector<test_t>(num_objects));
+        meter.measure([&] { return json::load<std::vector<test_header_t>>(text); });
+    };
+
+    BENCHMARK_ADVANCED("json::deserialize (invalid input)")(Chronometer meter)
+    {
+        auto doc = json::serialize(std::vector<test_t>(num_objects));
+        doc[static_cast<rapidjson::SizeType>(num_objects - 1)]["i"].SetString("not an int");
+        meter.measure([&] {
+            try
+            {
+                return json::deserialize<std::vector<test_t>>(doc).size();
+            }
+            catch (const serialization::deserialize_error&)
+            {
+                return std::size_t{0};
+            }
+        });
+    };
+
+    BENCHMARK_ADVANCED("json::try_deserialize (invalid input)")(Chronometer meter)
+    {
+        auto doc = json::serialize(std::vector<test_t>(num_objects));
+        doc[static_cast<rapidjson::SizeType>(num_objects - 1)]["i"].SetString("not an int");
+        std::vector<test_t> out;
+        json::deserialize_context ctx;
+        serialization::deserialize_status status;
+        meter.measure([&] { return json::try_deserialize(out, doc, ctx, status); });
+    };
+
+    BENCHMARK_ADVANCED("parse + deserialize + serialize + dump")(Chronometer meter)
+    {
+        const auto text = json::dump(std::vector<test_t>(num_objects));
+        std::vector<test_t> objs;
+
+        meter.measure([&] {
+            auto doc = json::parse(text);
+            json::deserialize(objs, doc);
+            json::owning_serialize_context ctx;
+            return to_string(json::serialize(objs, ctx)).size();
+        });
+    };
+
+    BENCHMARK_ADVANCED("parse + deserialize + serialize + dump (json::arena)")(Chronometer meter)
+    {
+        // Elements of std::vector<test_t> are constructed anew by deserialize(),
+        // along with their strings, vectors and map, so only the arena's part
+        // of this cycle is allocation free
+        const auto text = json::dump(std::vector<test_t>(num_objects));
+        std::vector<test_t> objs;
+        json::arena arena;
+
+        meter.measure([&] {
+            arena.reset();
+            json::deserialize(objs, json::parse(text, arena));
+            json::serialize_context ctx{arena};
+            return json::dump(json::view{json::serialize(objs, ctx)}, arena).size();
+        });
+    };
+
+    BENCHMARK_ADVANCED("parse + serialize + dump (json::arena, no allocations)")(Chronometer meter)
+    {
+        const std::vector<test_t> objs(num_objects);
+        const auto text = json::dump(objs);
+        json::arena arena;
+
+        auto cycle = [&] {
+            arena.reset();
+            const auto size = json::parse(text, arena).Size();
+            json::serialize_context ctx{arena};
+            return size + json::dump(json::view{json::serialize(objs, ctx)}, arena).size();
+        };
+
+        // Once warmed up neither the arena nor anything else touches the heap
+        cycle();
+        cycle();
+        const auto capacity = arena.capacity();
+        REQUIRE(count_allocations(cycle) == 0);
+        REQUIRE(arena.capacity() == capacity);
+
+        meter.measure(cycle);
+    };
+
+    BENCHMARK_ADVANCED("parse + deserialize + serialize + dump (json::arena, flat records)")(
+        Chronometer meter)
+    {
+        // Records without members of their own on the heap: deserializing into
+        // the same vector reuses its capacity, so the whole cycle is allocation free
+        const auto text = json::dump(std::vector<inner_t>(10 * num_objects));
+        std::vector<inner_t> objs;
+        json::arena arena;
+
+        auto cycle = [&] {
+            arena.reset();
+            json::deserialize(objs, json::parse(text, arena));
+            json::serialize_context ctx{arena};
+            return json::dump(json::view{json::serialize(objs, ctx)}, arena).size();
+        };
+
+        cycle();
+        cycle();
+        const auto capacity = arena.capacity();
+        REQUIRE(count_allocations(cycle) == 0);
+        REQUIRE(arena.capacity() == capacity);
+
+        meter.measure(cycle);
+    };
+
+    BENCHMARK_ADVANCED("json::for_each_line")(Chronometer meter)
+    {
+        std::string text;
+        for (int i = 0; i < 10 * num_objects; ++i)
+            text += json::dump(test_t{}) + '\n';
+
+        json::lines_options opts;
+        opts.chunk_size = 64 * 1024;
+        meter.measure([&] {
+            std::size_t count = 0;
+            json::for_each_line<test_t>(text, [&](test_t&&) { ++count; }, opts);
+            return count;
+        });
+    };
+
+    BENCHMARK_ADVANCED("json::for_each_line (single thread)")(Chronometer meter)
+    {
+        std::string text;
+        for (int i = 0; i < 10 * num_objects; ++i)
+            text += json::dump(test_t{}) + '\n';
+
+        json::lines_options opts;
+        opts.chunk_size = 64 * 1024;
+        opts.num_threads = 1;
+        meter.measure([&] {
+            std::size_t count = 0;
+            json::for_each_line<test_t>(text, [&](test_t&&) { ++count; }, opts);
+            return count;
+        });
+    };
 }
@@ -0,0 +1,80 @@
+#include "kl/json.hpp"
+#include "kl/msgpack.hpp"
+#include "input/typedefs.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <vector>
+
+TEST_CASE("msgpack bench")
+{
+    using namespace kl;
+    using Catch::Benchmark::Chronometer;
+
+    constexpr int num_objects = 100;
+
+    BENCHMARK_ADVANCED("msgpack::dump")(Chronometer meter)
+    {
+        const std::vector<test_t> input(num_objects);
+        meter.measure([&] { return msgpack::dump(input); });
+    };
+
+    BENCHMARK_ADVANCED("json::dump")(Chronometer meter)
+    {
+        const std::vector<test_t> input(num_objects);
+        meter.measure([&] { return json::dump(input); });
+    };
+
+    BENCHMARK_ADVANCED("msgpack::dump (floats)")(Chronometer meter)
+    {
+        const std::vector<telemetry_t> input(10 * num_objects);
+        meter.measure([&] { return msgpack::dump(input); });
+    };
+
+    BENCHMARK_ADVANCED("json::dump (floats)")(Chronometer meter)
+    {
+        const std::vector<telemetry_t> input(10 * num_objects);
+        meter.measure([&] { return json::dump(input); });
+    };
+
+    BENCHMARK_ADVANCED("msgpack::parse + msgpack::deserialize")(Chronometer meter)
+    {
+        const auto buffer = msgpack::dump(std::vector<test_t>(num_objects));
+        meter.measure(
+            [&] { return msgpack::deserialize<std::vector<test_t>>(msgpack::parse(buffer)); });
+    };
+
+    BENCHMARK_ADVANCED("json::parse + json::deserialize")(Chronometer meter)
+    {
+        const auto text = json::dump(std::vector<test_t>(num_objects));
+        meter.measure(
+            [&] { return json::deserialize<std::vector<test_t>>(json::parse(text)); });
+    };
+
+    // Fixed size ranges, tuples and structs read from sequences walk elements
+    // in order instead of looking each one up by index
+    BENCHMARK_ADVANCED("msgpack::deserialize (std::array)")(Chronometer meter)
+    {
+        using array_t = std::array<int, 50000>;
+        const auto buffer = msgpack::dump(std::vector<int>(array_t{}.size(), 7));
+        const auto value = msgpack::parse(buffer);
+        array_t out;
+        meter.measure([&] {
+            msgpack::deserialize(out, value);
+            return out[0];
+        });
+    };
+
+    BENCHMARK_ADVANCED("json::deserialize (std::array)")(Chronometer meter)
+    {
+        using array_t = std::array<int, 50000>;
+        const auto doc = json::serialize(std::vector<int>(array_t{}.size(), 7));
+        array_t out;
+        meter.measure([&] {
+            json::deserialize(out, doc);
+            return out[0];
+        });
+    };
+}
@@ -2,14 +2,31 @@
 
 #include "kl/utility.hpp"
 
+#include <boost/endian/conversion.hpp>
 #include <gsl/span>
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <type_traits>
+#include <vector>
 
 namespace kl {
 
+// How binary_reader/binary_writer encode container lengths. `fixed` always
+// takes 4 bytes (std::uint32_t), `compact` uses LEB128 varints which take 1
+// byte for lengths below 128.
+enum class binary_encoding
+{
+    fixed,
+    compact
+};
+
 namespace detail {
 
 template <typename T>
@@ -56,6 +73,10 @@ public:
     // Useful in user-provided operator>> for composite types to fail fast
     void notify_error() noexcept { err_ = true; }
 
+    // Both sides must agree on the encoding, it's not stored in the data
+    binary_encoding encoding() const noexcept { return encoding_; }
+    void set_encoding(binary_encoding encoding) noexcept { encoding_ = encoding; }
+
 protected:
     T* cursor() const noexcept { return buffer_.data() + pos_; }
 
@@ -63,19 +84,115 @@ protected:
     gsl::span<T> buffer_;
     std::size_t pos_{0};
     bool err_{false};
+    binary_encoding encoding_{binary_encoding::fixed};
 };
 
+// Longest LEB128 encoding of 64-bit value
+inline constexpr std::size_t max_varint_size = 10;
+
+inline unsigned countr_zero(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned n = 0;
+    for (; !(value & 1); value >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+// Decodes up to 8 bytes long varint without a loop. `word` holds the bytes in
+// little endian order with everything past the terminating byte cleared.
+constexpr std::uint64_t pack_varint_groups(std::uint64_t word) noexcept
+{
+    // Drop continuation bits and squeeze 7-bit groups together: 2x7 -> 14,
+    // 2x14 -> 28 and finally 2x28 -> 56 bits
+    word &= 0x7f7f7f7f7f7f7f7fULL;
+    word = ((word & 0x7f007f007f007f00ULL) >> 1) | (word & 0x007f007f007f007fULL);
+    word = ((word & 0x3fff00003fff0000ULL) >> 2) | (word & 0x00003fff00003fffULL);
+    word = ((word & 0x0fffffff00000000ULL) >> 4) | (word & 0x000000000fffffffULL);
+    return word;
+}
+
 template <typename T>
 using is_simple =
     std::bool_constant<std::is_arithmetic<T>::value || std::is_enum<T>::value>;
 
 } // namespace detail
 
+// Cursor over bytes already validated by binary_reader::unchecked(). Reads
+// neither check bounds nor track errors, so that decoding fixed-size layouts
+// (structs of scalars) takes a single check instead of one per field.
+class unchecked_binary_reader
+{
+public:
+    // Invalid cursor, see binary_reader::unchecked()
+    unchecked_binary_reader() noexcept = default;
+
+    explicit unchecked_binary_reader(gsl::span<const std::byte> region) noexcept
+        : cursor_{region.data()}, end_{region.data() + region.size()}, valid_{true}
+    {
+    }
+
+    explicit operator bool() const noexcept { return valid_; }
+
+    std::size_t left() const noexcept { return static_cast<std::size_t>(end_ - cursor_); }
+
+    template <typename T>
+    void read_raw(T& value) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "T must be a trivially copyable type");
+        assert(left() >= sizeof(T));
+
+        std::memcpy(&value, cursor_, sizeof(T));
+        cursor_ += sizeof(T);
+    }
+
+private:
+    const std::byte* cursor_{nullptr};
+    const std::byte* end_{nullptr};
+    bool valid_{false};
+};
+
+// read_unchecked implementation for all basic types + enum types. Overloads
+// are only provided for types with fixed encoded size.
+template <typename T, enable_if<detail::is_simple<T>> = true>
+void read_unchecked(unchecked_binary_reader& r, T& value) noexcept
+{
+    r.read_raw(value);
+}
+
+template <typename T>
+unchecked_binary_reader& operator>>(unchecked_binary_reader& r, T& value) noexcept
+{
+    read_unchecked(r, value);
+    return r;
+}
+
 class binary_reader : public detail::cursor_base<const std::byte>
 {
 public:
     using detail::cursor_base<const std::byte>::cursor_base;
 
+    void skip(std::ptrdiff_t off) noexcept
+    {
+        if (off > 0 && !err_ && !has(static_cast<std::size_t>(off)))
+        {
+            // Refilling reader might not be able to buffer all of it at once
+            while (refill_ && static_cast<std::size_t>(off) > left())
+            {
+                off -= static_cast<std::ptrdiff_t>(left());
+                pos_ = buffer_.size();
+                if (!refill_(*this, 1))
+                    break;
+            }
+        }
+
+        detail::cursor_base<const std::byte>::skip(off);
+    }
+
     template <typename T>
     bool peek(T& value) noexcept
     {
@@ -106,6 +223,49 @@ public:
                          span.size_bytes());
     }
 
+    // Reads LEB128 encoded value
+    bool read_varint(std::uint64_t& value) noexcept
+    {
+        if (err_)
+            return false;
+
+        // Fast path: whole varint within next 8 bytes, decoded without branching
+        // on each byte. Doesn't refill: a short varint near the end of what a
+        // stream has delivered so far must not wait for bytes it doesn't need.
+        if (left() >= sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, cursor(), sizeof(word));
+            word = boost::endian::little_to_native(word);
+
+            if (const auto stops = ~word & 0x8080808080808080ULL)
+            {
+                // Keep bytes up to (and including) the first one without continuation bit
+                value = detail::pack_varint_groups(word & (stops ^ (stops - 1)));
+                pos_ += detail::countr_zero(stops) / 8 + 1;
+                return true;
+            }
+        }
+
+        return read_varint_slow(value);
+    }
+
+    // Reads container's length as written by binary_writer::write_length()
+    std::uint32_t read_length() noexcept
+    {
+        if (encoding_ == binary_encoding::fixed)
+        {
+            std::uint32_t length{};
+            read_raw(length);
+            return length;
+        }
+
+        std::uint64_t length{};
+        if (read_varint(length) && length > UINT32_MAX)
+            err_ = true;
+        return err_ ? 0 : static_cast<std::uint32_t>(length);
+    }
+
 public:
     template <typename T>
     bool read(T& value)
@@ -134,10 +294,31 @@ public:
         return value;
     }
 
+    // Makes sure next `size` bytes can be read (pulling them in for refilling
+    // readers) without consuming them, sets the error otherwise
+    bool ensure(std::size_t size) noexcept
+    {
+        if (!err_ && !has(size))
+            err_ = true;
+        return !err_;
+    }
+
+    // Validates next `size` bytes at once and consumes them. The returned
+    // cursor reads them without further checks and evaluates to false on
+    // error:
+    //
+    //   if (auto u = r.unchecked(binary_size<point>()))
+    //       u >> pt.x >> pt.y;
+    unchecked_binary_reader unchecked(std::size_t size) noexcept
+    {
+        const auto region = span(size);
+        return err_ ? unchecked_binary_reader{} : unchecked_binary_reader{region};
+    }
+
     // Does not copy the data
     gsl::span<const std::byte> span(std::size_t count, bool move_cursor = true)
     {
-        if (count > static_cast<std::size_t>(left()))
+        if (!err_ && !has(count))
             err_ = true;
         if (err_)
             return {};
@@ -149,10 +330,26 @@ public:
         return ret;
     }
 
+protected:
+    // Invoked when a read needs more than left() bytes. Lets a derived reader
+    // bring in more data (by rebinding buffer_ and pos_) instead of failing.
+    // Returns whether at least `size` bytes are available afterwards.
+    using refill_function = bool (*)(binary_reader& r, std::size_t size) noexcept;
+
+    binary_reader(gsl::span<const std::byte> buffer, refill_function refill) noexcept
+        : detail::cursor_base<const std::byte>{buffer}, refill_{refill}
+    {
+    }
+
 private:
+    bool has(std::size_t size) noexcept
+    {
+        return left() >= size || (refill_ && refill_(*this, size));
+    }
+
     bool peek_impl(std::byte* data, std::size_t size) noexcept
     {
-        if (err_ || static_cast<std::size_t>(left()) < size)
+        if (err_ || !has(size))
             return false;
 
         std::memcpy(data, cursor(), size);
@@ -162,12 +359,67 @@ private:
     bool read_impl(std::byte* data, std::size_t size) noexcept
     {
         if (peek_impl(data, size))
+        {
             pos_ += size;
-        else
+            return true;
+        }
+
+        // Refilling reader might not be able to buffer all of it at once
+        while (!err_ && refill_ && left() < size)
+        {
+            const auto chunk = left();
+            if (chunk)
+                std::memcpy(data, cursor(), chunk);
+            data += chunk;
+            size -= chunk;
+            pos_ += chunk;
+
+            if (!refill_(*this, 1))
+                break;
+        }
+
+        if (err_ || left() < size)
+        {
             err_ = true;
+            return false;
+        }
 
-        return !err_;
+        if (size)
+            std::memcpy(data, cursor(), size);
+        pos_ += size;
+        return true;
     }
+
+    bool read_varint_slow(std::uint64_t& value) noexcept
+    {
+        std::uint64_t result = 0;
+
+        for (std::size_t i = 0; i < detail::max_varint_size; ++i)
+        {
+            // Pull in one byte at a time, refilling moves the data around
+            if (!has(i + 1))
+                break;
+
+            const auto byte = static_cast<std::uint8_t>(cursor()[i]);
+            result |= static_cast<std::uint64_t>(byte & 0x7f) << (7 * i);
+
+            if (!(byte & 0x80))
+            {
+                // Last of 10 bytes can only carry the 64th bit
+                if (i == detail::max_varint_size - 1 && byte > 1)
+                    break;
+                value = result;
+                pos_ += i + 1;
+                return true;
+            }
+        }
+
+        err_ = true;
+        return false;
+    }
+
+private:
+    refill_function refill_{nullptr};
 };
 
 // read_binary implementation for all basic types + enum types
@@ -177,8 +429,9 @@ void read_binary(binary_reader& r, T& value) noexcept
     r.read_raw(value);
 }
 
-// read_binary implementation for all basic types + enum types
-template <typename T, std::size_t Extent>
+// read_binary implementation for spans, copies the data into the span. See
+// read_borrowed() in kl/binary_rw/vector.hpp for borrowing a std::vector<T>.
+template <typename T, std::size_t Extent, enable_if<std::negation<std::is_const<T>>> = true>
 void read_binary(binary_reader& r, gsl::span<T, Extent> span)
 {
     r.read_span(span);
@@ -192,7 +445,7 @@ binary_reader& operator>>(binary_reader& r, T& value)
 }
 
 // This must be present to allow for rvalue spans
-template <typename T, std::size_t Extent>
+template <typename T, std::size_t Extent, enable_if<std::negation<std::is_const<T>>> = true>
 binary_reader& operator>>(binary_reader& r, gsl::span<T, Extent> span)
 {
     read_binary(r, span);
@@ -222,26 +475,284 @@ public:
         static_assert(std::is_trivially_copyable<T>::value,
                       "T must be a trivially copyable type");
 
-        return write_impl(reinterpret_cast<const std::byte*>(span.data()),
-                          span.size_bytes());
+        const auto* data = reinterpret_cast<const std::byte*>(span.data());
+        if (reference_ && !err_ && !references_suspended_ &&
+            reference_(*this, data, span.size_bytes()))
+            return true;
+
+        return write_impl(data, span.size_bytes());
+    }
+
+    // Writes LEB128 encoded value
+    bool write_varint(std::uint64_t value) noexcept
+    {
+        std::byte data[detail::max_varint_size];
+        std::size_t size = 0;
+        for (; value >= 0x80; value >>= 7)
+            data[size++] = static_cast<std::byte>(value | 0x80);
+        data[size++] = static_cast<std::byte>(value);
+        return write_impl(data, size);
+    }
+
+    // Writes container's length using current encoding()
+    bool write_length(std::size_t length) noexcept
+    {
+        if (encoding_ == binary_encoding::fixed)
+            return write_raw(static_cast<std::uint32_t>(length));
+        return write_varint(length);
+    }
+
+    // Moves the cursor past `count` bytes and returns them to be filled in by
+    // the caller, e.g. when the data needs converting on the way anyway
+    gsl::span<std::byte> span(std::size_t count) noexcept
+    {
+        if (!make_room(count))
+            return {};
+
+        gsl::span<std::byte> ret(cursor(), count);
+        pos_ += count;
+
+        return ret;
+    }
+
+    // Bytes written so far, e.g. to patch a header once the payload following
+    // it is known. Invalidated by subsequent writes.
+    gsl::span<std::byte> written() const noexcept { return {buffer_.data(), pos_}; }
+
+    // Makes write_span() copy the data into the buffer even if a derived writer
+    // could keep a reference to it instead, until matched by
+    // resume_references(). Used for frames whose checksum must cover the
+    // whole payload. Calls nest.
+    void suspend_references() noexcept { ++references_suspended_; }
+    void resume_references() noexcept { --references_suspended_; }
+
+protected:
+    // Invoked when a write doesn't fit in the remaining buffer. Lets a derived
+    // writer make more room (by rebinding buffer_) instead of failing.
+    using grow_function = bool (*)(binary_writer& w, std::size_t size) noexcept;
+    // Invoked by write_span(). Lets a derived writer keep a reference to the
+    // data instead of copying it. Returns false to have it copied as usual.
+    using reference_function = bool (*)(binary_writer& w, const std::byte* data,
+                                         std::size_t size) noexcept;
+
+    binary_writer(gsl::span<std::byte> buffer, grow_function grow,
+                  reference_function reference = nullptr) noexcept
+        : detail::cursor_base<std::byte>{buffer}, grow_{grow}, reference_{reference}
+    {
     }
 
 private:
-    bool write_impl(const std::byte* data, std::size_t size) noexcept
+    bool make_room(std::size_t size) noexcept
     {
-        if (err_ || static_cast<std::size_t>(left()) < size)
+        if (err_ || (static_cast<std::size_t>(left()) < size && !(grow_ && grow_(*this, size))))
         {
             err_ = true;
             return false;
         }
 
-        std::memcpy(cursor(), data, size);
+        return true;
+    }
+
+    bool write_impl(const std::byte* data, std::size_t size) noexcept
+    {
+        if (!make_room(size))
+            return false;
+
+        if (size)
+            std::memcpy(cursor(), data, size);
         pos_ += size;
 
         return true;
     }
+
+private:
+    grow_function grow_{nullptr};
+    reference_function reference_{nullptr};
+    unsigned references_suspended_{0};
+};
+
+// binary_writer that owns its buffer and grows it geometrically as needed so
+// the encoded size doesn't have to be known up-front. All write_binary
+// overloads work with it as they take binary_writer&. left() reports the
+// currently unused capacity only.
+template <typename Allocator = std::allocator<std::byte>>
+class basic_growable_binary_writer : public binary_writer
+{
+    static constexpr std::size_t min_capacity = 64;
+
+public:
+    explicit basic_growable_binary_writer(std::size_t capacity = 0,
+                                          const Allocator& alloc = Allocator{})
+        : binary_writer{gsl::span<std::byte>{}, &grow}, storage_(alloc)
+    {
+        reserve(capacity);
+    }
+
+    // buffer_ points into storage_
+    basic_growable_binary_writer(const basic_growable_binary_writer&) = delete;
+    basic_growable_binary_writer& operator=(const basic_growable_binary_writer&) = delete;
+
+    // Bytes written so far. Invalidated by subsequent writes.
+    gsl::span<const std::byte> bytes() const noexcept { return {storage_.data(), pos_}; }
+
+    // Hands over the written bytes without copying and starts over with an empty buffer
+    std::vector<std::byte, Allocator> release()
+    {
+        storage_.resize(pos_);
+        auto ret = std::move(storage_);
+        storage_.clear();
+        buffer_ = {};
+        pos_ = 0;
+        err_ = false;
+        return ret;
+    }
+
+    // Starts over, keeping the capacity
+    void clear() noexcept
+    {
+        pos_ = 0;
+        err_ = false;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > storage_.size())
+            rebind(capacity);
+    }
+
+protected:
+    basic_growable_binary_writer(std::size_t capacity, const Allocator& alloc,
+                                 reference_function reference)
+        : binary_writer{gsl::span<std::byte>{}, &grow, reference}, storage_(alloc)
+    {
+        reserve(capacity);
+    }
+
+private:
+    static bool grow(binary_writer& w, std::size_t size) noexcept
+    {
+        auto& self = static_cast<basic_growable_binary_writer&>(w);
+        try
+        {
+            self.rebind((std::max)({self.storage_.size() * 2, self.pos_ + size, min_capacity}));
+            return true;
+        }
+        catch (const std::bad_alloc&)
+        {
+            return false;
+        }
+    }
+
+    void rebind(std::size_t capacity)
+    {
+        storage_.resize(capacity);
+        buffer_ = {storage_.data(), storage_.size()};
+    }
+
+private:
+    std::vector<std::byte, Allocator> storage_;
 };
 
+using growable_binary_writer = basic_growable_binary_writer<>;
+// Takes its memory from the given std::pmr::memory_resource (e.g. a
+// std::pmr::monotonic_buffer_resource used as an arena)
+using pmr_binary_writer = basic_growable_binary_writer<std::pmr::polymorphic_allocator<std::byte>>;
+
+// Growable writer which doesn't copy big spans (blobs, long strings, vectors of
+// trivial types) into its buffer but keeps references to them. The message is
+// then sent as a list of segments with writev()/sendmsg() (or WSASend()), so
+// that the payload goes to the kernel without an extra copy. Referenced data
+// must stay alive and unchanged until segments() are consumed.
+template <typename Allocator = std::allocator<std::byte>>
+class basic_gather_binary_writer : public basic_growable_binary_writer<Allocator>
+{
+    using base = basic_growable_binary_writer<Allocator>;
+
+public:
+    static constexpr std::size_t default_min_reference_size = 256;
+
+    explicit basic_gather_binary_writer(
+        std::size_t min_reference_size = default_min_reference_size,
+        std::size_t capacity = 0, const Allocator& alloc = Allocator{})
+        : base{capacity, alloc, &reference},
+          min_reference_size_{min_reference_size},
+          references_(alloc)
+    {
+    }
+
+    // Own buffer alone doesn't hold the whole message, use segments()
+    gsl::span<const std::byte> bytes() const noexcept = delete;
+    std::vector<std::byte, Allocator> release() = delete;
+
+    // Message as a list of contiguous pieces in order, to be turned into
+    // iovec/WSABUF. Invalidated by subsequent writes.
+    std::vector<gsl::span<const std::byte>> segments() const
+    {
+        const auto own = base::bytes();
+        std::vector<gsl::span<const std::byte>> ret;
+        ret.reserve(2 * references_.size() + 1);
+
+        std::size_t prev = 0;
+        for (const auto& ref : references_)
+        {
+            if (ref.pos > prev)
+                ret.push_back(own.subspan(prev, ref.pos - prev));
+            ret.push_back(ref.data);
+            prev = ref.pos;
+        }
+        if (own.size() > prev)
+            ret.push_back(own.subspan(prev));
+
+        return ret;
+    }
+
+    // Total size of the message, pos() counts only bytes in the own buffer
+    std::size_t size() const noexcept { return this->pos_ + referenced_size_; }
+
+    void clear() noexcept
+    {
+        base::clear();
+        references_.clear();
+        referenced_size_ = 0;
+    }
+
+private:
+    static bool reference(binary_writer& w, const std::byte* data, std::size_t size) noexcept
+    {
+        auto& self = static_cast<basic_gather_binary_writer&>(w);
+        if (size < self.min_reference_size_)
+            return false;
+
+        try
+        {
+            self.references_.push_back({self.pos_, {data, size}});
+            self.referenced_size_ += size;
+            return true;
+        }
+        catch (const std::bad_alloc&)
+        {
+            // Just copy it then
+            return false;
+        }
+    }
+
+    struct reference_entry
+    {
+        // Where in the own buffer the referenced data goes
+        std::size_t pos;
+        gsl::span<const std::byte> data;
+    };
+
+private:
+    std::size_t min_reference_size_;
+    std::vector<reference_entry,
+                typename std::allocator_traits<Allocator>::template rebind_alloc<reference_entry>>
+        references_;
+    std::size_t referenced_size_{0};
+};
+
+using gather_binary_writer = basic_gather_binary_writer<>;
+
 // write_binary implementation for all basic types + enum types
 template <typename T, enable_if<detail::is_simple<T>> = true>
 void write_binary(binary_writer& w, const T& value) noexcept
@@ -262,4 +773,110 @@ binary_writer& operator<<(binary_writer& w, const T& value)
     write_binary(w, value);
     return w;
 }
+
+// Tag for binary_size(binary_size_tag, const T&) overloads. Each write_binary
+// overload has a matching one returning the exact number of bytes it writes
+// with given encoding.
+struct binary_size_tag
+{
+    binary_encoding encoding{binary_encoding::fixed};
+};
+
+constexpr std::size_t varint_binary_size(std::uint64_t value) noexcept
+{
+    std::size_t size = 1;
+    for (; value >= 0x80; value >>= 7)
+        ++size;
+    return size;
+}
+
+// Size of the length written by binary_writer::write_length()
+constexpr std::size_t length_binary_size(binary_size_tag tag, std::size_t length) noexcept
+{
+    return tag.encoding == binary_encoding::fixed ? sizeof(std::uint32_t)
+                                                  : varint_binary_size(length);
+}
+
+// Encoded size of T if it doesn't depend on the value, 0 otherwise
+template <typename T, typename = void>
+struct fixed_binary_size : std::integral_constant<std::size_t, 0> {};
+
+template <typename T>
+struct fixed_binary_size<T, std::enable_if_t<detail::is_simple<T>::value>>
+    : std::integral_constant<std::size_t, sizeof(T)> {};
+
+template <typename T>
+inline constexpr std::size_t fixed_binary_size_v = fixed_binary_size<T>::value;
+
+// Whether T is written exactly as its in-memory representation, so that arrays
+// of T can be copied in and out of the buffer at once
+template <typename T, typename = void>
+struct has_trivial_binary_layout : detail::is_simple<T> {};
+
+template <typename T>
+inline constexpr bool has_trivial_binary_layout_v = has_trivial_binary_layout<T>::value;
+
+// Whether T has fixed encoded size and can be read with unchecked_binary_reader
+template <typename T, typename = void>
+struct is_unchecked_readable : std::false_type {};
+
+template <typename T>
+struct is_unchecked_readable<T, std::void_t<decltype(read_unchecked(
+                                    std::declval<unchecked_binary_reader&>(), std::declval<T&>()))>>
+    : std::bool_constant<fixed_binary_size_v<T> != 0> {};
+
+template <typename T>
+inline constexpr bool is_unchecked_readable_v = is_unchecked_readable<T>::value;
+
+// binary_size implementation for all basic types + enum types
+template <typename T, enable_if<detail::is_simple<T>> = true>
+constexpr std::size_t binary_size(binary_size_tag, const T&) noexcept
+{
+    return sizeof(T);
+}
+
+// binary_size implementation for spans
+template <typename T, std::size_t Extent>
+constexpr std::size_t binary_size(binary_size_tag, gsl::span<T, Extent> span) noexcept
+{
+    return span.size_bytes();
+}
+
+// Returns how many bytes `w << value` writes. Lets one allocate the exact
+// buffer (e.g. in shared memory or a mapped file) and serialize in one pass.
+template <typename T>
+std::size_t binary_size(const T& value, binary_encoding encoding = binary_encoding::fixed)
+{
+    return binary_size(binary_size_tag{encoding}, value);
+}
+
+// Same as above but for types with fixed encoded size only
+template <typename T>
+constexpr std::size_t binary_size() noexcept
+{
+    static_assert(fixed_binary_size_v<T> != 0, "T has no fixed binary size");
+    return fixed_binary_size_v<T>;
+}
+
+namespace detail {
+
+// Total size of range's elements, in constant time if they're of fixed size
+template <typename Range>
+std::size_t elements_binary_size(binary_size_tag tag, const Range& rng)
+{
+    using value_type = typename Range::value_type;
+
+    if constexpr (fixed_binary_size_v<value_type> != 0)
+    {
+        return rng.size() * fixed_binary_size_v<value_type>;
+    }
+    else
+    {
+        std::size_t size = 0;
+        for (const auto& item : rng)
+            size += binary_size(tag, item);
+        return size;
+    }
+}
+} // namespace detail
 } // namespace kl
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "kl/binary_rw.hpp"
+#include "kl/binary_rw/varint.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <gsl/span>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kl {
+
+namespace detail {
+
+inline constexpr std::size_t delta_block_size = 128;
+
+inline unsigned bit_width(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value ? 64 - static_cast<unsigned>(__builtin_clzll(value)) : 0;
+#else
+    unsigned n = 0;
+    for (; value; value >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+inline constexpr std::size_t packed_size(std::size_t count, unsigned bits) noexcept
+{
+    return (count * bits + 7) / 8;
+}
+
+// Differences between neighbours of one block stored as offsets from the
+// smallest of them, each taking `bits` bits
+template <typename T>
+struct delta_block
+{
+    using unsigned_type = std::make_unsigned_t<T>;
+    using signed_type = std::make_signed_t<T>;
+
+    // Differences wrap around so that any sequence can be encoded
+    static unsigned_type difference(T prev, T value) noexcept
+    {
+        return static_cast<unsigned_type>(static_cast<unsigned_type>(value) -
+                                          static_cast<unsigned_type>(prev));
+    }
+
+    // Encodes values[1..count] following values[0] into `offsets`
+    delta_block(const T* values, std::size_t count, unsigned_type* offsets) noexcept
+    {
+        auto min = (std::numeric_limits<signed_type>::max)();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            offsets[i] = difference(values[i], values[i + 1]);
+            min = (std::min)(min, static_cast<signed_type>(offsets[i]));
+        }
+
+        std::uint64_t all = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            offsets[i] = static_cast<unsigned_type>(offsets[i] - static_cast<unsigned_type>(min));
+            all |= offsets[i];
+        }
+
+        base = min;
+        bits = bit_width(all);
+    }
+
+    std::size_t binary_size(std::size_t count) const noexcept
+    {
+        return varint_binary_size(zigzag_encode(base)) + sizeof(std::uint8_t) +
+               packed_size(count, bits);
+    }
+
+    signed_type base;
+    unsigned bits;
+};
+
+template <typename UInt>
+void pack_bits(const UInt* values, std::size_t count, unsigned bits, std::byte* out) noexcept
+{
+    std::uint64_t acc = 0;
+    unsigned filled = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto value = static_cast<std::uint64_t>(values[i]);
+        acc |= value << filled;
+        filled += bits;
+        if (filled >= 64)
+        {
+            boost::endian::store_little_u64(reinterpret_cast<unsigned char*>(out), acc);
+            out += sizeof(acc);
+            filled -= 64;
+            acc = filled ? value >> (bits - filled) : 0;
+        }
+    }
+
+    for (; filled > 0; filled -= (std::min)(filled, 8U), acc >>= 8)
+        *out++ = static_cast<std::byte>(acc);
+}
+
+// `data` must be readable for 16 bytes past the packed values. Each value is
+// extracted independently of the others so the loop has no dependency chain.
+template <typename UInt>
+void unpack_bits(const std::byte* data, std::size_t count, unsigned bits, UInt* values) noexcept
+{
+    auto load = [data](std::size_t offset) {
+        return boost::endian::load_little_u64(reinterpret_cast<const unsigned char*>(data) +
+                                              offset);
+    };
+    const auto mask = bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+
+    if (bits <= 56)
+    {
+        // Any value fits in a word loaded from its first byte
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto offset = i * bits;
+            values[i] = static_cast<UInt>((load(offset / 8) >> (offset % 8)) & mask);
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto offset = i * bits;
+        const auto shift = static_cast<unsigned>(offset % 8);
+        auto value = load(offset / 8) >> shift;
+        if (shift)
+            value |= load(offset / 8 + 8) << (64 - shift);
+        values[i] = static_cast<UInt>(value & mask);
+    }
+}
+
+template <typename T>
+void check_delta_encodable() noexcept
+{
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8,
+                  "delta encoding requires an integral type");
+}
+} // namespace detail
+
+// Integer sequences (timestamps, sorted IDs, counters) are written as the
+// first value followed by the differences between neighbours. Differences are
+// grouped in blocks of 128 stored as the smallest one (frame of reference) and
+// bit-packed offsets from it, all using the bit width of the largest offset.
+// A block is bounds checked once and decoded without branching on each value:
+// unpacking offsets then a prefix sum, instead of varint by varint.
+//
+//   [length][first value varint]([base varint][u8 bit width][packed offsets])...
+template <typename T, std::size_t Extent>
+bool write_delta_encoded(kl::binary_writer& w, gsl::span<const T, Extent> values)
+{
+    detail::check_delta_encodable<T>();
+    using block_type = detail::delta_block<T>;
+
+    w.write_length(values.size());
+    if (values.empty())
+        return !w.err();
+
+    w.write_varint(varint<T>{values[0]}.encoded());
+
+    std::array<typename block_type::unsigned_type, detail::delta_block_size> offsets;
+    std::array<std::byte, detail::delta_block_size * sizeof(T)> packed;
+    for (std::size_t i = 1; i < values.size() && !w.err();)
+    {
+        const auto count = (std::min)(values.size() - i, detail::delta_block_size);
+        const block_type block{values.data() + i - 1, count, offsets.data()};
+
+        detail::pack_bits(offsets.data(), count, block.bits, packed.data());
+
+        w.write_varint(zigzag_encode(block.base));
+        w << static_cast<std::uint8_t>(block.bits);
+        w.write_span(gsl::span<const std::byte>{packed.data(),
+                                                detail::packed_size(count, block.bits)});
+        i += count;
+    }
+
+    return !w.err();
+}
+
+template <typename T, typename Allocator>
+bool read_delta_encoded(kl::binary_reader& r, std::vector<T, Allocator>& values)
+{
+    detail::check_delta_encodable<T>();
+    using block_type = detail::delta_block<T>;
+    using unsigned_type = typename block_type::unsigned_type;
+
+    values.clear();
+    const auto size = r.read_length();
+    if (!size || r.err())
+        return !r.err();
+
+    varint<T> first;
+    std::uint64_t encoded{};
+    if (!r.read_varint(encoded) || !first.decode(encoded))
+    {
+        r.notify_error();
+        return false;
+    }
+
+    // The length isn't trusted: values grow block by block as each one is
+    // read, so a corrupted length fails on the first missing block instead
+    // of allocating it all up front. Blocks take at least 2 bytes for up to
+    // 128 values, which bounds what the remaining input can hold.
+    values.reserve((std::min)(std::size_t{size}, 1 + r.left() * (detail::delta_block_size / 2)));
+    values.resize(1);
+    values[0] = first;
+
+    std::array<unsigned_type, detail::delta_block_size> offsets;
+    // Room for unpack_bits() to read whole words past the end
+    std::array<std::byte, detail::delta_block_size * sizeof(T) + 16> packed{};
+    auto acc = static_cast<unsigned_type>(values[0]);
+
+    for (std::size_t i = 1; i < size;)
+    {
+        const auto count = (std::min)(size - i, detail::delta_block_size);
+
+        varint<typename block_type::signed_type> base;
+        std::uint8_t bits{};
+        if (!r.read_varint(encoded) || !base.decode(encoded) || !r.read(bits) ||
+            bits > std::numeric_limits<unsigned_type>::digits)
+        {
+            r.notify_error();
+            values.clear();
+            return false;
+        }
+
+        const auto data = r.span(detail::packed_size(count, bits));
+        if (r.err())
+        {
+            values.clear();
+            return false;
+        }
+
+        std::memcpy(packed.data(), data.data(), data.size());
+        detail::unpack_bits(packed.data(), count, bits, offsets.data());
+
+        values.resize(i + count);
+        const auto min = static_cast<unsigned_type>(base.value());
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            acc = static_cast<unsigned_type>(acc + min + offsets[j]);
+            values[i + j] = static_cast<T>(acc);
+        }
+
+        i += count;
+    }
+
+    return true;
+}
+
+// Wrapper for a vector of integers written with write_delta_encoded() instead
+// of element by element. Pays off when neighbouring values are close, e.g. as
+// a field type:
+//
+//   struct ticks { kl::delta_encoded<std::vector<std::int64_t>> timestamps; ... };
+template <typename Container>
+class delta_encoded
+{
+public:
+    using value_type = Container;
+
+    delta_encoded() = default;
+    delta_encoded(Container value) : value_{std::move(value)} {}
+
+    Container& value() noexcept { return value_; }
+    const Container& value() const noexcept { return value_; }
+
+private:
+    Container value_{};
+};
+
+template <typename Container>
+void write_binary(kl::binary_writer& w, const delta_encoded<Container>& value)
+{
+    using T = typename Container::value_type;
+    write_delta_encoded(w, gsl::span<const T>{value.value().data(), value.value().size()});
+}
+
+template <typename Container>
+void read_binary(kl::binary_reader& r, delta_encoded<Container>& value)
+{
+    read_delta_encoded(r, value.value());
+}
+
+template <typename Container>
+std::size_t binary_size(kl::binary_size_tag tag, const delta_encoded<Container>& value)
+{
+    using T = typename Container::value_type;
+    using block_type = detail::delta_block<T>;
+
+    const auto& values = value.value();
+
+    auto size = length_binary_size(tag, values.size());
+    if (values.empty())
+        return size;
+
+    size += varint_binary_size(varint<T>{values[0]}.encoded());
+
+    std::array<typename block_type::unsigned_type, detail::delta_block_size> offsets;
+    for (std::size_t i = 1; i < values.size();)
+    {
+        const auto count = (std::min)(values.size() - i, detail::delta_block_size);
+        size += block_type{values.data() + i - 1, count, offsets.data()}.binary_size(count);
+        i += count;
+    }
+
+    return size;
+}
+} // namespace kl
@@ -3,9 +3,134 @@
 #include "kl/binary_rw.hpp"
 
 #include <boost/endian/arithmetic.hpp>
+#include <gsl/span>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 
 namespace kl {
 
+namespace detail {
+
+// Copies `count` elements of `size` bytes each (2, 4 or 8) reversing the byte
+// order of every one of them. Uses SSSE3/AVX2 when the CPU supports it. `dst`
+// and `src` may be the same but must not overlap otherwise.
+void reverse_bytes_copy(std::byte* dst, const std::byte* src, std::size_t count,
+                        std::size_t size) noexcept;
+
+using reverse_bytes_kernel = void (*)(std::byte* dst, const std::byte* src, std::size_t count,
+                                      std::size_t size) noexcept;
+
+// reverse_bytes_copy() implementations this CPU can run, the scalar one first
+// and the one reverse_bytes_copy() uses last. Exposed so that tests can check
+// each of them.
+gsl::span<const reverse_bytes_kernel> reverse_bytes_kernels() noexcept;
+
+template <typename T>
+inline constexpr bool is_endian_convertible_v =
+    (std::is_arithmetic_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <boost::endian::order Order, typename T>
+void copy_from_order(T* dst, const std::byte* src, std::size_t count) noexcept
+{
+    static_assert(is_endian_convertible_v<T>, "T must be an arithmetic or enum type");
+
+    if constexpr (Order == boost::endian::order::native || sizeof(T) == 1)
+    {
+        if (count)
+            std::memcpy(dst, src, count * sizeof(T));
+    }
+    else
+    {
+        reverse_bytes_copy(reinterpret_cast<std::byte*>(dst), src, count, sizeof(T));
+    }
+}
+
+template <boost::endian::order Order, typename T>
+void copy_to_order(std::byte* dst, const T* src, std::size_t count) noexcept
+{
+    static_assert(is_endian_convertible_v<T>, "T must be an arithmetic or enum type");
+
+    if constexpr (Order == boost::endian::order::native || sizeof(T) == 1)
+    {
+        if (count)
+            std::memcpy(dst, src, count * sizeof(T));
+    }
+    else
+    {
+        reverse_bytes_copy(dst, reinterpret_cast<const std::byte*>(src), count, sizeof(T));
+    }
+}
+} // namespace detail
+
+// Reads span.size() values stored in `Order` byte order and converts them to
+// host order at once. Same as reading them one by one as
+// boost::endian::endian_arithmetic<Order, T, ...> but much faster for big arrays.
+template <boost::endian::order Order, typename T, std::size_t Extent>
+bool read_endian_span(binary_reader& r, gsl::span<T, Extent> span) noexcept
+{
+    static_assert(!std::is_const_v<T>, "can't read into span of const elements");
+
+    const auto data = r.span(span.size_bytes());
+    if (r.err())
+        return false;
+
+    detail::copy_from_order<Order>(span.data(), data.data(), span.size());
+    return true;
+}
+
+// Writes all values in `Order` byte order, counterpart of read_endian_span()
+template <boost::endian::order Order, typename T, std::size_t Extent>
+bool write_endian_span(binary_writer& w, gsl::span<T, Extent> span) noexcept
+{
+    const auto data = w.span(span.size_bytes());
+    if (w.err())
+        return false;
+
+    detail::copy_to_order<Order>(data.data(), span.data(), span.size());
+    return true;
+}
+
+// Converts array of endian_arithmetic values (e.g. a span of big_int32_t
+// borrowed from a binary_reader) to host order values
+template <boost::endian::order Order, typename T, std::size_t n_bits,
+          boost::endian::align Align, std::size_t Extent>
+void load_endian_span(
+    gsl::span<const boost::endian::endian_arithmetic<Order, T, n_bits, Align>, Extent> src,
+    gsl::span<T> dst) noexcept
+{
+    static_assert(n_bits == sizeof(T) * 8, "padded endian types are not supported");
+    assert(src.size() == dst.size());
+
+    detail::copy_from_order<Order>(dst.data(), reinterpret_cast<const std::byte*>(src.data()),
+                                   src.size());
+}
+
+// Reverse of load_endian_span()
+template <boost::endian::order Order, typename T, std::size_t n_bits,
+          boost::endian::align Align, std::size_t Extent>
+void store_endian_span(
+    gsl::span<const T, Extent> src,
+    gsl::span<boost::endian::endian_arithmetic<Order, T, n_bits, Align>> dst) noexcept
+{
+    static_assert(n_bits == sizeof(T) * 8, "padded endian types are not supported");
+    assert(src.size() == dst.size());
+
+    detail::copy_to_order<Order>(reinterpret_cast<std::byte*>(dst.data()), src.data(),
+                                 src.size());
+}
+
+template <boost::endian::order Order, typename T, std::size_t n_bits,
+          boost::endian::align Align>
+struct fixed_binary_size<boost::endian::endian_arithmetic<Order, T, n_bits, Align>>
+    : std::integral_constant<std::size_t,
+                             sizeof(boost::endian::endian_arithmetic<Order, T, n_bits, Align>)>
+{
+};
+
 template <boost::endian::order Order, typename T, std::size_t n_bits,
           boost::endian::align Align>
 void write_binary(
@@ -23,4 +148,22 @@ void read_binary(
 {
     r.read_raw(value);
 }
+
+template <boost::endian::order Order, typename T, std::size_t n_bits,
+          boost::endian::align Align>
+void read_unchecked(
+    unchecked_binary_reader& r,
+    boost::endian::endian_arithmetic<Order, T, n_bits, Align>& value) noexcept
+{
+    r.read_raw(value);
+}
+
+template <boost::endian::order Order, typename T, std::size_t n_bits,
+          boost::endian::align Align>
+constexpr std::size_t binary_size(
+    kl::binary_size_tag,
+    const boost::endian::endian_arithmetic<Order, T, n_bits, Align>& value) noexcept
+{
+    return sizeof(value);
+}
 } // namespace kl
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "kl/binary_rw.hpp"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace kl {
+
+// CRC-32C (Castagnoli) of `data`. Pass the previous result as `crc` to
+// checksum data arriving in pieces: crc32c(b, crc32c(a)) == crc32c(a + b).
+// Uses the SSE4.2 crc32 instruction when available.
+std::uint32_t crc32c(gsl::span<const std::byte> data, std::uint32_t crc = 0) noexcept;
+
+namespace detail {
+
+// Updates the CRC register without the initial and final inversions of crc32c()
+using crc32c_kernel = std::uint32_t (*)(const std::byte* data, std::size_t size,
+                                        std::uint32_t crc) noexcept;
+
+// crc32c() implementations this CPU can run, the portable one first and the
+// one crc32c() uses last. Exposed so that tests can check each of them.
+gsl::span<const crc32c_kernel> crc32c_kernels() noexcept;
+} // namespace detail
+
+// Frames delimit records in a log or a stream so that a damaged one can be
+// detected and skipped without losing the rest. Each frame is laid out as:
+//
+//   [u32 payload length][u32 CRC-32C of the length and the payload][payload]
+//
+// in native byte order like the rest of binary_rw.
+inline constexpr std::size_t frame_header_size = 2 * sizeof(std::uint32_t);
+
+// Starts a frame by reserving room for its header. Returns the frame's offset
+// to be passed to end_frame() once the payload has been written. Until then
+// gather_binary_writer copies big spans instead of referencing them so that
+// the whole payload is in the writer's buffer.
+std::size_t begin_frame(binary_writer& w) noexcept;
+
+// Fills in the header of the frame started at `frame` with the length and the
+// checksum of everything written since. Must be called for every
+// begin_frame(), also when writing failed.
+bool end_frame(binary_writer& w, std::size_t frame) noexcept;
+
+template <typename T>
+bool write_frame(binary_writer& w, const T& value)
+{
+    const auto frame = begin_frame(w);
+    w << value;
+    return end_frame(w, frame);
+}
+
+// Reads the next frame and returns a reader over its payload, which borrows
+// from `r` (and is invalidated by the next read from a stream_binary_reader).
+// A frame whose checksum doesn't match is skipped and std::nullopt returned
+// with r.err() unset so the caller can carry on with the next one. A
+// truncated frame sets r.err().
+std::optional<binary_reader> read_frame(binary_reader& r) noexcept;
+} // namespace kl
@@ -9,7 +9,7 @@ namespace kl {
 template <typename K, typename V>
 void write_binary(kl::binary_writer& w, const std::map<K, V>& map)
 {
-    w << static_cast<std::uint32_t>(map.size());
+    w.write_length(map.size());
 
     for (const auto& kv : map)
     {
@@ -21,7 +21,7 @@ void write_binary(kl::binary_writer& w, const std::map<K, V>& map)
 template <typename K, typename V>
 void read_binary(kl::binary_reader& r, std::map<K, V>& map)
 {
-    const auto size = r.read<std::uint32_t>();
+    const auto size = r.read_length();
     map.clear();
 
     for (std::uint32_t i = 0; i < size; ++i)
@@ -34,4 +34,24 @@ void read_binary(kl::binary_reader& r, std::map<K, V>& map)
         }
     }
 }
+
+template <typename K, typename V>
+std::size_t binary_size(kl::binary_size_tag tag, const std::map<K, V>& map)
+{
+    if constexpr (fixed_binary_size_v<K> != 0 && fixed_binary_size_v<V> != 0)
+    {
+        return length_binary_size(tag, map.size()) +
+               map.size() * (fixed_binary_size_v<K> + fixed_binary_size_v<V>);
+    }
+    else
+    {
+        std::size_t size = length_binary_size(tag, map.size());
+        for (const auto& kv : map)
+        {
+            size += binary_size(tag, kv.first);
+            size += binary_size(tag, kv.second);
+        }
+        return size;
+    }
+}
 } // namespace kl
@@ -23,4 +23,10 @@ void read_binary(kl::binary_reader& r, std::optional<T>& opt)
     else
         opt = std::nullopt;
 }
+
+template <typename T>
+std::size_t binary_size(kl::binary_size_tag tag, const std::optional<T>& opt)
+{
+    return sizeof(std::uint8_t) + (opt ? binary_size(tag, *opt) : 0);
+}
 } // namespace kl
@@ -6,6 +6,13 @@
 
 namespace kl {
 
+template <typename T1, typename T2>
+struct fixed_binary_size<std::pair<T1, T2>, std::enable_if_t<fixed_binary_size_v<T1> != 0 &&
+                                                             fixed_binary_size_v<T2> != 0>>
+    : std::integral_constant<std::size_t, fixed_binary_size_v<T1> + fixed_binary_size_v<T2>>
+{
+};
+
 template <typename T1, typename T2>
 void write_binary(kl::binary_writer& w, const std::pair<T1, T2>& pair)
 {
@@ -13,14 +20,32 @@ void write_binary(kl::binary_writer& w, const std::pair<T1, T2>& pair)
     w << pair.second;
 }
 
+template <typename T1, typename T2,
+          enable_if<is_unchecked_readable<T1>, is_unchecked_readable<T2>> = true>
+void read_unchecked(kl::unchecked_binary_reader& r, std::pair<T1, T2>& pair) noexcept
+{
+    r >> pair.first >> pair.second;
+}
+
 template <typename T1, typename T2>
 void read_binary(kl::binary_reader& r, std::pair<T1, T2>& pair)
 {
-    if (!r.err())
+    if constexpr (is_unchecked_readable_v<std::pair<T1, T2>>)
+    {
+        if (auto u = r.unchecked(fixed_binary_size_v<std::pair<T1, T2>>))
+            u >> pair;
+    }
+    else if (!r.err())
     {
         r >> pair.first;
         if (!r.err())
             r >> pair.second;
     }
 }
+
+template <typename T1, typename T2>
+std::size_t binary_size(kl::binary_size_tag tag, const std::pair<T1, T2>& pair)
+{
+    return binary_size(tag, pair.first) + binary_size(tag, pair.second);
+}
 } // namespace kl
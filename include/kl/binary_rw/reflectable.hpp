@@ -0,0 +1,276 @@
+#pragma once
+
+#include "kl/binary_rw.hpp"
+#include "kl/ctti.hpp"
+#include "kl/serialization_attributes.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace kl {
+
+namespace detail {
+
+// Fields are written back-to-back in reflection order with no names nor
+// framing. Since the layout is positional a field marked with either
+// skip_serialization or skip_deserialization is left out in both directions,
+// otherwise reading back what was written would go out of sync.
+template <typename Field>
+constexpr bool is_binary_skipped_field() noexcept
+{
+    return Field::template has<serialization::attributes::skip_serialization_t>() ||
+           Field::template has<serialization::attributes::skip_deserialization_t>();
+}
+
+// Returned by write_binary() and read_binary() overloads for reflectables. A
+// reflected type may still have its own binary format (e.g. when it's only
+// reflected for JSON), the shortcuts below must not bypass it then.
+struct reflectable_binary_rw
+{
+};
+
+// Whether T is written and read field by field by the overloads below
+template <typename T, typename = void>
+struct uses_reflectable_binary_rw : std::false_type
+{
+};
+
+template <typename T>
+struct uses_reflectable_binary_rw<
+    T, std::enable_if_t<std::is_same_v<decltype(write_binary(std::declval<binary_writer&>(),
+                                                             std::declval<const T&>())),
+                                       reflectable_binary_rw> &&
+                        std::is_same_v<decltype(read_binary(std::declval<binary_reader&>(),
+                                                            std::declval<T&>())),
+                                       reflectable_binary_rw>>> : std::true_type
+{
+};
+
+template <typename T>
+using is_binary_reflectable =
+    std::conjunction<ctti::is_reflectable<T>, uses_reflectable_binary_rw<T>>;
+
+// Sum of fields' fixed sizes or 0 if any of them has variable size
+template <typename T>
+constexpr std::size_t reflectable_fixed_binary_size() noexcept
+{
+    std::size_t size = 0;
+    bool fixed = true;
+    ctti::reflect_type<T>([&size, &fixed](auto field) {
+        using field_type = decltype(field);
+        if constexpr (!is_binary_skipped_field<field_type>())
+        {
+            constexpr auto field_size = fixed_binary_size_v<typename field_type::value_type>;
+            fixed = fixed && field_size != 0;
+            size += field_size;
+        }
+    });
+    return fixed ? size : 0;
+}
+
+// Whether all (not skipped) fields can be read with unchecked_binary_reader
+template <typename T>
+constexpr bool reflectable_is_unchecked_readable() noexcept
+{
+    if constexpr (!is_binary_reflectable<T>::value)
+    {
+        return false;
+    }
+    else
+    {
+        bool readable = true;
+        ctti::reflect_type<T>([&readable](auto field) {
+            using field_type = decltype(field);
+            if constexpr (!is_binary_skipped_field<field_type>())
+                readable = readable && is_unchecked_readable_v<typename field_type::value_type>;
+        });
+        return readable;
+    }
+}
+
+// Fields must be raw themselves and add up to the size of T, so they cover all
+// of it with no padding in between
+template <typename T>
+constexpr bool reflectable_fields_cover_object() noexcept
+{
+    std::size_t size = 0;
+    bool raw = true;
+    ctti::reflect_type<T>([&size, &raw](auto field) {
+        using field_type = decltype(field);
+        using value_type = typename field_type::value_type;
+        if constexpr (is_binary_skipped_field<field_type>() ||
+                      !has_trivial_binary_layout_v<value_type>)
+            raw = false;
+        else
+            size += sizeof(value_type);
+    });
+    return raw && size == sizeof(T);
+}
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define KL_BINARY_RW_CONSTEXPR_BIT_CAST(type_, value_) __builtin_bit_cast(type_, value_)
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1927
+#define KL_BINARY_RW_CONSTEXPR_BIT_CAST(type_, value_) __builtin_bit_cast(type_, value_)
+#endif
+
+#if defined(KL_BINARY_RW_CONSTEXPR_BIT_CAST)
+
+// Whether fields are listed in the order they're laid out, each one starting
+// where the previous one ends. Offsets are found without constructing T (its
+// default member initializers needn't be constexpr) nor comparing addresses:
+// T is made out of bytes set to bit `b` of their own offset, so the first byte
+// of each field gives bit `b` of the field's offset. Only 0 and 1 are used so
+// that the bytes are valid for bool fields too.
+template <typename T>
+constexpr bool reflectable_fields_in_layout_order() noexcept
+{
+    using object_bytes = std::array<unsigned char, sizeof(T)>;
+
+    std::array<std::size_t, ctti::num_fields<T>()> offsets{};
+    bool direct = true;
+
+    for (std::size_t bit = 0; (std::size_t{1} << bit) < sizeof(T); ++bit)
+    {
+        object_bytes bytes{};
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<unsigned char>((i >> bit) & 1);
+
+        const auto object = KL_BINARY_RW_CONSTEXPR_BIT_CAST(T, bytes);
+        std::size_t index = 0;
+        ctti::reflect_object(object, [&](auto field) {
+            using value_type = typename decltype(field)::value_type;
+            using field_bytes = std::array<unsigned char, sizeof(value_type)>;
+
+            // Accessor fields computing their value don't map onto T's bytes
+            if constexpr (!std::is_lvalue_reference_v<decltype(field.value())>)
+            {
+                direct = false;
+            }
+            else
+            {
+                const auto value = KL_BINARY_RW_CONSTEXPR_BIT_CAST(field_bytes, field.value());
+                offsets[index] |= std::size_t{value[0]} << bit;
+            }
+            ++index;
+        });
+    }
+
+    std::size_t expected = 0;
+    std::size_t index = 0;
+    bool ordered = direct;
+    ctti::reflect_type<T>([&](auto field) {
+        using value_type = typename decltype(field)::value_type;
+        ordered = ordered && offsets[index++] == expected;
+        expected += sizeof(value_type);
+    });
+    return ordered;
+}
+
+#else
+
+// Can't find out fields' offsets at compile time, always write field by field
+template <typename T>
+constexpr bool reflectable_fields_in_layout_order() noexcept
+{
+    return false;
+}
+
+#endif
+
+// Otherwise writing fields one by one gives different bytes than copying the
+// whole object
+template <typename T>
+constexpr bool reflectable_has_trivial_binary_layout() noexcept
+{
+    if constexpr (!std::is_trivially_copyable_v<T> || !std::is_standard_layout_v<T>)
+        return false;
+    else if constexpr (!reflectable_fields_cover_object<T>())
+        return false;
+    else
+        return reflectable_fields_in_layout_order<T>();
+}
+} // namespace detail
+
+template <typename T>
+struct fixed_binary_size<T, std::enable_if_t<detail::is_binary_reflectable<T>::value>>
+    : std::integral_constant<std::size_t, detail::reflectable_fixed_binary_size<T>()>
+{
+};
+
+// Reflected PODs (e.g. struct point { float x, y, z; }) qualify, so vectors of
+// them are read and written with one memcpy
+template <typename T>
+struct has_trivial_binary_layout<T, std::enable_if_t<detail::is_binary_reflectable<T>::value>>
+    : std::bool_constant<detail::reflectable_has_trivial_binary_layout<T>()>
+{
+};
+
+template <typename T, enable_if<ctti::is_reflectable<T>> = true>
+detail::reflectable_binary_rw write_binary(kl::binary_writer& w, const T& value)
+{
+    ctti::reflect_object(value, [&w](auto field) {
+        if constexpr (!detail::is_binary_skipped_field<decltype(field)>())
+            w << field.value();
+    });
+    return {};
+}
+
+template <typename T,
+          enable_if<std::bool_constant<detail::reflectable_is_unchecked_readable<T>()>> = true>
+void read_unchecked(kl::unchecked_binary_reader& r, T& value) noexcept
+{
+    ctti::reflect_object(value, [&r](auto field) {
+        if constexpr (!detail::is_binary_skipped_field<decltype(field)>())
+            r >> field.value();
+    });
+}
+
+template <typename T, enable_if<ctti::is_reflectable<T>> = true>
+detail::reflectable_binary_rw read_binary(kl::binary_reader& r, T& value)
+{
+    if constexpr (has_trivial_binary_layout_v<T>)
+    {
+        r.read_raw(value);
+    }
+    else if constexpr (is_unchecked_readable_v<T>)
+    {
+        // Check bounds once for all the fields
+        if (auto u = r.unchecked(fixed_binary_size_v<T>))
+            u >> value;
+    }
+    else
+    {
+        ctti::reflect_object(value, [&r](auto field) {
+            if constexpr (!detail::is_binary_skipped_field<decltype(field)>())
+            {
+                if (!r.err())
+                    r >> field.value();
+            }
+        });
+    }
+    return {};
+}
+
+template <typename T, enable_if<detail::is_binary_reflectable<T>> = true>
+std::size_t binary_size(kl::binary_size_tag tag, const T& value)
+{
+    if constexpr (fixed_binary_size_v<T> != 0)
+    {
+        (void)tag;
+        (void)value;
+        return fixed_binary_size_v<T>;
+    }
+    else
+    {
+        std::size_t size = 0;
+        ctti::reflect_object(value, [tag, &size](auto field) {
+            if constexpr (!detail::is_binary_skipped_field<decltype(field)>())
+                size += binary_size(tag, field.value());
+        });
+        return size;
+    }
+}
+} // namespace kl
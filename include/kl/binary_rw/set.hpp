@@ -9,7 +9,7 @@ namespace kl {
 template <typename T>
 void write_binary(kl::binary_writer& w, const std::set<T>& set)
 {
-    w << static_cast<std::uint32_t>(set.size());
+    w.write_length(set.size());
 
     for (const auto& key : set)
         w << key;
@@ -18,7 +18,7 @@ void write_binary(kl::binary_writer& w, const std::set<T>& set)
 template <typename T>
 void read_binary(kl::binary_reader& r, std::set<T>& set)
 {
-    const auto size = r.read<std::uint32_t>();
+    const auto size = r.read_length();
     set.clear();
 
     for (std::uint32_t i = 0; i < size; ++i)
@@ -31,4 +31,10 @@ void read_binary(kl::binary_reader& r, std::set<T>& set)
         }
     }
 }
+
+template <typename T>
+std::size_t binary_size(kl::binary_size_tag tag, const std::set<T>& set)
+{
+    return length_binary_size(tag, set.size()) + detail::elements_binary_size(tag, set);
+}
 } // namespace kl
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "kl/binary_rw.hpp"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace kl {
+
+// binary_reader pulling its data on demand from a byte source (file
+// descriptor, pipe, socket or any callback) into a bounded buffer, so that
+// arbitrarily long streams are decoded in constant memory as they arrive.
+// Unread bytes are moved to the front of the buffer when more data is needed
+// so reads always see contiguous memory and all read_binary overloads work
+// as they are. Arrays bigger than the buffer are copied out piece by piece
+// but fixed-size values read through unchecked() must fit in the buffer.
+//
+// Data borrowed with span(), read_borrowed() or read into std::string_view
+// (and payloads of read_frame()) is only valid until the next read. It must
+// also fit in the buffer as a whole: bigger borrowed reads fail with err()
+// set, so size `capacity` for the largest one expected. left() and empty()
+// report the buffered bytes only, use at_end() to see if the whole stream has
+// been consumed.
+class stream_binary_reader : public binary_reader
+{
+public:
+    // Reads at most buffer.size() bytes into the buffer. Returns how many were
+    // read, 0 at the end of stream or a negative value on error. Exceptions
+    // thrown are treated as errors, they don't escape the reader.
+    using source_function = std::function<std::ptrdiff_t(gsl::span<std::byte> buffer)>;
+
+    static constexpr std::size_t default_capacity = 64 * 1024;
+
+    explicit stream_binary_reader(source_function source,
+                                  std::size_t capacity = default_capacity);
+    // Reads from the file descriptor which is left open afterwards
+    explicit stream_binary_reader(int fd, std::size_t capacity = default_capacity);
+
+    // buffer_ points into storage_
+    stream_binary_reader(const stream_binary_reader&) = delete;
+    stream_binary_reader& operator=(const stream_binary_reader&) = delete;
+
+    // Blocks until there's more data or the source is exhausted
+    bool at_end() noexcept;
+
+    // Number of bytes consumed since the beginning of the stream (pos() is
+    // relative to the current buffer)
+    std::uint64_t offset() const noexcept { return consumed_ + pos_; }
+
+private:
+    static bool refill(binary_reader& r, std::size_t size) noexcept;
+
+private:
+    source_function source_;
+    std::vector<std::byte> storage_;
+    std::uint64_t consumed_{0};
+    bool eof_{false};
+};
+} // namespace kl
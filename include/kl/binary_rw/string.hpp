@@ -5,12 +5,14 @@
 #include <gsl/span_ext>
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace kl {
 
 void write_binary(kl::binary_writer& w, const std::string& str)
 {
-    w << static_cast<std::uint32_t>(str.size());
+    w.write_length(str.size());
 
     if (!str.empty())
         w << gsl::span<const char>{str};
@@ -18,7 +20,7 @@ void write_binary(kl::binary_writer& w, const std::string& str)
 
 void read_binary(kl::binary_reader& r, std::string& str)
 {
-    const auto size = r.read<std::uint32_t>();
+    const auto size = r.read_length();
     str.clear();
 
     if (!size)
@@ -30,4 +32,36 @@ void read_binary(kl::binary_reader& r, std::string& str)
     if (r.err())
         str.clear();
 }
+
+inline std::size_t binary_size(kl::binary_size_tag tag, const std::string& str) noexcept
+{
+    return length_binary_size(tag, str.size()) + str.size();
+}
+
+// Same format as std::string. Templates so that string literals and other
+// things convertible to both still pick the std::string overload.
+template <typename StringView, enable_if<std::is_same<StringView, std::string_view>> = true>
+void write_binary(kl::binary_writer& w, StringView str)
+{
+    w.write_length(str.size());
+
+    if (!str.empty())
+        w << gsl::span<const char>{str.data(), str.size()};
+}
+
+// Doesn't allocate nor copy: `str` points into the reader's buffer which must
+// outlive it
+inline void read_binary(kl::binary_reader& r, std::string_view& str)
+{
+    const auto size = r.read_length();
+    const auto data = r.span(size);
+    str = r.err() ? std::string_view{}
+                  : std::string_view{reinterpret_cast<const char*>(data.data()), data.size()};
+}
+
+template <typename StringView, enable_if<std::is_same<StringView, std::string_view>> = true>
+std::size_t binary_size(kl::binary_size_tag tag, StringView str) noexcept
+{
+    return length_binary_size(tag, str.size()) + str.size();
+}
 } // namespace kl
@@ -1,34 +1,60 @@
 #pragma once
 
 #include "kl/binary_rw.hpp"
-#include "kl/meta.hpp"
 
+#include <gsl/span>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 #include <variant>
 
 namespace kl {
 namespace detail {
 
+template <typename Variant, std::size_t Index>
+void read_variant_alternative(kl::binary_reader& r, Variant& variant)
+{
+    using alternative = std::variant_alternative_t<Index, Variant>;
+
+    alternative value = r.read<alternative>();
+    if (!r.err())
+        variant.template emplace<Index>(std::move(value));
+}
+
 template <typename Variant>
-void visit_by_index(kl::binary_reader& r, kl::type_pack<>, Variant&,
-                    std::uint8_t)
+using variant_reader = void (*)(kl::binary_reader&, Variant&);
+
+template <typename Variant, std::size_t... Is>
+constexpr auto make_variant_readers(std::index_sequence<Is...>) noexcept
 {
-    r.notify_error();
+    return std::array<variant_reader<Variant>, sizeof...(Is)>{
+        &read_variant_alternative<Variant, Is>...};
 }
 
-template <typename Head, typename... Tail, typename Variant>
-void visit_by_index(kl::binary_reader& r, kl::type_pack<Head, Tail...>,
-                    Variant& variant, std::uint8_t index)
+// Decoder of each alternative indexed by the stored index so that decoding
+// takes the same time whichever alternative it is
+template <typename Variant>
+inline constexpr auto variant_readers = make_variant_readers<Variant>(
+    std::make_index_sequence<std::variant_size_v<Variant>>{});
+
+template <typename Variant>
+void read_variant(kl::binary_reader& r, Variant& var)
 {
-    if (index == 0)
-    {
-        Head value = r.read<Head>();
-        if (!r.err())
-            variant = std::move(value);
-    }
-    else
+    constexpr auto& readers = variant_readers<Variant>;
+
+    const auto index = r.read<std::uint8_t>();
+    if (r.err())
+        return;
+
+    if (index >= readers.size())
     {
-        visit_by_index(r, kl::type_pack<Tail...>{}, variant, index - 1);
+        r.notify_error();
+        return;
     }
+
+    readers[index](r, var);
 }
 } // namespace detail
 
@@ -42,10 +68,27 @@ void write_binary(kl::binary_writer& w, const std::variant<Args...>& var)
 template <typename... Args>
 void read_binary(kl::binary_reader& r, std::variant<Args...>& var)
 {
-    const auto index = r.read<std::uint8_t>();
-    if (!r.err())
+    detail::read_variant(r, var);
+}
+
+// Reads variants written one after another (e.g. a stream of messages) into
+// `vars`. Stops at the first error, returns whether all were read.
+template <typename... Args, std::size_t Extent>
+bool read_variants(kl::binary_reader& r, gsl::span<std::variant<Args...>, Extent> vars)
+{
+    for (auto& var : vars)
     {
-        visit_by_index(r, kl::type_pack<Args...>{}, var, index);
+        detail::read_variant(r, var);
+        if (r.err())
+            return false;
     }
+    return true;
+}
+
+template <typename... Args>
+std::size_t binary_size(kl::binary_size_tag tag, const std::variant<Args...>& var)
+{
+    return sizeof(std::uint8_t) +
+           std::visit([tag](const auto& value) { return binary_size(tag, value); }, var);
 }
 } // namespace kl
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "kl/binary_rw.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace kl {
+
+// Maps signed integers to unsigned so that values of small magnitude (either
+// sign) get short varint encodings: 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...
+constexpr std::uint64_t zigzag_encode(std::int64_t value) noexcept
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^
+           static_cast<std::uint64_t>(value < 0 ? -1 : 0);
+}
+
+constexpr std::int64_t zigzag_decode(std::uint64_t value) noexcept
+{
+    return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+// Integral wrapper that is written as a LEB128 varint (zig-zag encoded for
+// signed types) instead of its full width. Use it as a field type (or wrap the
+// value in place) where most values are small:
+//
+//   struct entry { kl::varint<std::int64_t> delta; ... };
+//   w << kl::varint{x};
+template <typename T>
+class varint
+{
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                  "varint requires an integral type");
+
+public:
+    using value_type = T;
+
+    constexpr varint() noexcept = default;
+    constexpr varint(T value) noexcept : value_{value} {}
+
+    constexpr T value() const noexcept { return value_; }
+    constexpr operator T() const noexcept { return value_; }
+
+    constexpr std::uint64_t encoded() const noexcept
+    {
+        if constexpr (std::is_signed_v<T>)
+            return zigzag_encode(value_);
+        else
+            return value_;
+    }
+
+    // Returns false if the decoded value doesn't fit in T
+    constexpr bool decode(std::uint64_t encoded) noexcept
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            const auto value = zigzag_decode(encoded);
+            if (value < (std::numeric_limits<T>::min)() || value > (std::numeric_limits<T>::max)())
+                return false;
+            value_ = static_cast<T>(value);
+        }
+        else
+        {
+            if (encoded > (std::numeric_limits<T>::max)())
+                return false;
+            value_ = static_cast<T>(encoded);
+        }
+        return true;
+    }
+
+private:
+    T value_{};
+};
+
+template <typename T>
+void write_binary(kl::binary_writer& w, const varint<T>& value)
+{
+    w.write_varint(value.encoded());
+}
+
+template <typename T>
+void read_binary(kl::binary_reader& r, varint<T>& value)
+{
+    std::uint64_t encoded;
+    if (r.read_varint(encoded) && !value.decode(encoded))
+        r.notify_error();
+}
+
+template <typename T>
+constexpr std::size_t binary_size(kl::binary_size_tag, const varint<T>& value) noexcept
+{
+    return varint_binary_size(value.encoded());
+}
+} // namespace kl
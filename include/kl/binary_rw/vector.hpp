@@ -3,18 +3,20 @@
 #include "kl/binary_rw.hpp"
 #include "kl/type_traits.hpp"
 
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace kl {
 
 namespace detail {
 
-// Specialized operator<< for vector<T> of trivially copyable type T
+// Specialized operator<< for vector<T> of T with trivial binary layout
 template <typename T>
 void encode_vector(kl::binary_writer& w, const std::vector<T>& vec,
                    std::true_type /*is_trivially_serializable*/)
 {
-    w << static_cast<std::uint32_t>(vec.size());
+    w.write_length(vec.size());
     w << gsl::span<const T>{vec};
 }
 
@@ -22,18 +24,18 @@ template <typename T>
 void encode_vector(kl::binary_writer& w, const std::vector<T>& vec,
                    std::false_type /*is_trivially_serializable*/)
 {
-    w << static_cast<std::uint32_t>(vec.size());
+    w.write_length(vec.size());
 
     for (const auto& item : vec)
         w << item;
 }
 
-// Specialized operator>> for vector<T> of trivial type T
+// Specialized operator>> for vector<T> of T with trivial binary layout
 template <typename T>
 void decode_vector(kl::binary_reader& r, std::vector<T>& vec,
                    std::true_type /*is_trivially_deserializable*/)
 {
-    const auto size = r.read<std::uint32_t>();
+    const auto size = r.read_length();
 
     vec.clear();
 
@@ -54,7 +56,7 @@ template <typename T>
 void decode_vector(kl::binary_reader& r, std::vector<T>& vec,
                    std::false_type /*is_trivially_deserializable*/)
 {
-    const auto size = r.read<std::uint32_t>();
+    const auto size = r.read_length();
 
     vec.clear();
     vec.reserve(size);
@@ -71,10 +73,10 @@ void decode_vector(kl::binary_reader& r, std::vector<T>& vec,
 }
 
 template <typename T>
-using is_trivially_serializable = std::bool_constant<is_simple<T>::value>;
+using is_trivially_serializable = std::bool_constant<has_trivial_binary_layout_v<T>>;
 
 template <typename T>
-using is_trivially_deserializable = std::bool_constant<is_simple<T>::value>;
+using is_trivially_deserializable = std::bool_constant<has_trivial_binary_layout_v<T>>;
 } // namespace detail
 
 template <typename T>
@@ -88,4 +90,46 @@ void read_binary(kl::binary_reader& r, std::vector<T>& vec)
 {
     detail::decode_vector(r, vec, detail::is_trivially_deserializable<T>{});
 }
+
+// Reads data written as std::vector<T> without allocating nor copying: `span`
+// points into the reader's buffer (which must outlive it). Elements are not
+// copied out so the data must be suitably aligned for T, otherwise it's an error.
+// Not a read_binary() overload since writing a gsl::span<const T> doesn't
+// write its length.
+template <typename T>
+bool read_borrowed(kl::binary_reader& r, gsl::span<const T>& span)
+{
+    static_assert(detail::is_trivially_deserializable<T>::value,
+                  "T must have trivial binary layout (see has_trivial_binary_layout)");
+
+    span = {};
+    const auto size = r.read_length();
+    if (!size || r.err())
+        return !r.err();
+
+    if (size > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+    {
+        r.notify_error();
+        return false;
+    }
+
+    const auto data = r.span(size * sizeof(T));
+    if (r.err())
+        return false;
+
+    if (reinterpret_cast<std::uintptr_t>(data.data()) % alignof(T) != 0)
+    {
+        r.notify_error();
+        return false;
+    }
+
+    span = {reinterpret_cast<const T*>(data.data()), size};
+    return true;
+}
+
+template <typename T>
+std::size_t binary_size(kl::binary_size_tag tag, const std::vector<T>& vec)
+{
+    return length_binary_size(tag, vec.size()) + detail::elements_binary_size(tag, vec);
+}
 } // namespace kl
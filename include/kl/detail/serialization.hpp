@@ -10,6 +10,7 @@
 #include "kl/type_traits.hpp"
 #include "kl/utility.hpp"
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <functional>
@@ -17,8 +18,10 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 namespace kl::serialization::detail {
@@ -526,13 +529,211 @@ void check_extra_field_key(const string_set& reserved_names, const Key& key)
     }
 }
 
+// Tells whether a field is looked up by its serialized name (or aliases) when
+// deserializing. Flattened and extra_fields fields consume the whole map instead.
+template <typename Field>
+constexpr bool is_named_deserializable_field()
+{
+    return !Field::template has<attributes::skip_deserialization_t>() &&
+           !Field::template has<attributes::extra_fields_t>() &&
+           !Field::template has<attributes::flatten_t>();
+}
+
+// One of the names (canonical or alias) a reflected field can be deserialized from
+struct field_name_entry
+{
+    std::string_view name;
+    // Index of the field in reflection order
+    std::size_t index;
+    // 0 for the canonical name, 1+ for consecutive aliases (lower wins)
+    std::size_t rank;
+};
+
+template <typename Reflectable>
+constexpr std::size_t field_name_count()
+{
+    std::size_t n = 0;
+    ctti::reflect_type<Reflectable, validator_attribute_filter>([&n](auto field) {
+        using Field = decltype(field);
+        if constexpr (is_named_deserializable_field<Field>())
+        {
+            ++n;
+            if constexpr (Field::template has<attributes::aliases_t>())
+            {
+                for (const char* alias : *field.template get<attributes::aliases_t>())
+                {
+                    (void)alias;
+                    ++n;
+                }
+            }
+        }
+    });
+    return n;
+}
+
+template <typename Reflectable>
+constexpr auto make_field_name_entries()
+{
+    std::array<field_name_entry, field_name_count<Reflectable>()> result{};
+    std::size_t n = 0;
+    std::size_t index = 0;
+
+    ctti::reflect_type<Reflectable, validator_attribute_filter>([&](auto field) {
+        using Field = decltype(field);
+        if constexpr (is_named_deserializable_field<Field>())
+        {
+            std::size_t rank = 0;
+            result[n++] = {serialized_name(field), index, rank++};
+            if constexpr (Field::template has<attributes::aliases_t>())
+            {
+                for (const char* alias : *field.template get<attributes::aliases_t>())
+                    result[n++] = {alias, index, rank++};
+            }
+        }
+        ++index;
+    });
+
+    // Insertion sort - std::sort is not constexpr in C++17
+    for (std::size_t i = 1; i < result.size(); ++i)
+    {
+        for (std::size_t j = i; j > 0 && result[j].name < result[j - 1].name; --j)
+        {
+            const field_name_entry tmp = result[j];
+            result[j] = result[j - 1];
+            result[j - 1] = tmp;
+        }
+    }
+    return result;
+}
+
+// Compile-time table of all names of Reflectable's deserializable fields,
+// sorted so a map key can be dispatched to its field with a binary search.
+template <typename Reflectable>
+struct field_name_table
+{
+    static constexpr auto entries = make_field_name_entries<Reflectable>();
+
+    static constexpr const field_name_entry* find(std::string_view name) noexcept
+    {
+        std::size_t first = 0;
+        std::size_t last = entries.size();
+        while (first < last)
+        {
+            const std::size_t mid = first + (last - first) / 2;
+            if (entries[mid].name < name)
+                first = mid + 1;
+            else
+                last = mid;
+        }
+        return first < entries.size() && entries[first].name == name ? &entries[first]
+                                                                      : nullptr;
+    }
+};
+
+KL_VALID_EXPR_HELPER(has_field_key, T::field_key(std::declval<const typename T::value_type&>()))
+
+// Member nodes are kept by value for handle-like node types (YAML::Node) and by
+// address for the rest (rapidjson::Value, which lives in its document anyway).
+template <typename Value>
+using field_node_slot =
+    std::conditional_t<std::is_copy_constructible_v<Value>, std::optional<Value>, const Value*>;
+
+template <typename Value>
+void store_field_node(std::optional<Value>& slot, const Value& node)
+{
+    slot.emplace(node);
+}
+
+template <typename Value>
+void store_field_node(const Value*& slot, const Value& node)
+{
+    slot = &node;
+}
+
+// Finds map members for Reflectable's fields. If the backend can expose member
+// keys as strings (Backend::field_key) the members are walked only once and
+// dispatched to fields using field_name_table. Otherwise each field is looked
+// up separately with has_field() and at_field().
+template <typename Backend, typename Reflectable>
+class field_lookup
+{
+    using value_type = typename Backend::value_type;
+    using slot_type = field_node_slot<value_type>;
+
+    static constexpr bool single_pass = has_field_key_v<Backend>;
+    static constexpr std::size_t num_slots = single_pass ? ctti::num_fields<Reflectable>() + 1 : 1;
+
+public:
+    explicit field_lookup(const value_type& value) : value_{value}
+    {
+        if constexpr (single_pass)
+        {
+            Backend::for_each_field(value, [this](const auto& key, const auto& node) {
+                const auto* entry = field_name_table<Reflectable>::find(Backend::field_key(key));
+                if (!entry)
+                    return;
+
+                // Canonical name takes precedence over aliases and the first
+                // occurrence of a duplicated key wins
+                auto& rank = ranks_[entry->index];
+                if (rank && rank <= entry->rank + 1)
+                    return;
+                rank = static_cast<unsigned char>(entry->rank + 1);
+                store_field_node(nodes_[entry->index], node);
+            });
+        }
+    }
+
+    // Returns the member node for the field (of given index) or nullptr if it's missing
+    template <typename Field>
+    const value_type* find(const Field& field, std::size_t index)
+    {
+        if constexpr (single_pass)
+        {
+            (void)field;
+            return ranks_[index] ? &*nodes_[index] : nullptr;
+        }
+        else
+        {
+            (void)index;
+            const char* name = resolve_field_name<Backend>(value_, field);
+            if (!name)
+                return nullptr;
+            store_field_node(nodes_[0], Backend::at_field(value_, name));
+            return &*nodes_[0];
+        }
+    }
+
+private:
+    const value_type& value_;
+    slot_type nodes_[num_slots]{};
+    unsigned char ranks_[num_slots]{};
+};
+
+// Identifies the reflected field whose key is being dumped. Lets the backend
+// precompute anything it needs per Reflectable (e.g. escaped keys) and look
+// it up by the field's index in reflection order.
+template <typename Reflectable>
+struct reflected_field_key
+{
+    std::size_t index;
+    const char* name;
+};
+
+// Optional backend hook used instead of write_key() for reflected fields
+KL_VALID_EXPR_HELPER(has_write_field_key,
+                     T::write_field_key(std::declval<reflected_field_key<void>>(),
+                                        std::declval<int&>()))
+
 template <typename Backend, typename Reflectable, typename Context>
 void dump_reflected_fields(const Reflectable& refl,
                            const string_set* reserved_names,
                            Context& ctx)
 {
-    ctti::reflect_object(refl, [&reserved_names, &ctx](auto field) {
+    ctti::reflect_object(refl, [&reserved_names, &ctx,
+                                index = std::size_t{0}](auto field) mutable {
         check_field_attributes<decltype(field)>();
+        const std::size_t field_index = index++;
 
         if constexpr (!has_attribute<attributes::skip_serialization_t>(field))
         {
@@ -558,7 +759,16 @@ void dump_reflected_fields(const Reflectable& refl,
                 }
                 else
                 {
-                    Backend::write_key(serialized_name(field), ctx);
+                    if constexpr (has_write_field_key_v<Backend>)
+                    {
+                        Backend::write_field_key(
+                            reflected_field_key<Reflectable>{field_index, serialized_name(field)},
+                            ctx);
+                    }
+                    else
+                    {
+                        Backend::write_key(serialized_name(field), ctx);
+                    }
                     Backend::dump(value, ctx);
                 }
             }
@@ -870,6 +1080,37 @@ void deserialize_adl(GrowableRange& out, const typename Backend::value_type& val
     });
 }
 
+// Hands out elements of a sequence one after another for deserializers that
+// consume all of them in order. Backends whose at_index() isn't constant time
+// provide a `sequence_cursor` of their own.
+template <typename Backend>
+class index_cursor
+{
+public:
+    explicit index_cursor(const typename Backend::value_type& value) noexcept : value_{value} {}
+
+    decltype(auto) next() { return Backend::at_index(value_, index_++); }
+
+private:
+    const typename Backend::value_type& value_;
+    std::size_t index_ = 0;
+};
+
+template <typename Backend, typename = void>
+struct sequence_cursor
+{
+    using type = index_cursor<Backend>;
+};
+
+template <typename Backend>
+struct sequence_cursor<Backend, std::void_t<typename Backend::sequence_cursor>>
+{
+    using type = typename Backend::sequence_cursor;
+};
+
+template <typename Backend>
+using sequence_cursor_t = typename sequence_cursor<Backend>::type;
+
 template <typename Backend, typename FixedSizeRange, typename Context,
           enable_if<std::negation<::kl::detail::is_map_alike<FixedSizeRange>>,
                     ::kl::detail::is_fixed_size_range<FixedSizeRange>> = true>
@@ -880,12 +1121,13 @@ void deserialize_adl(FixedSizeRange& out, const typename Backend::value_type& va
     if (out.size() < Backend::size(value))
         throw deserialize_error{"sequence size is greater than declared range field count"};
 
+    sequence_cursor_t<Backend> elements{value};
     std::size_t index = 0;
     for (auto& element : out)
     {
         try
         {
-            Backend::deserialize(element, Backend::at_index(value, index), ctx);
+            Backend::deserialize(element, elements.next(), ctx);
             ++index;
         }
         catch (deserialize_error& ex)
@@ -909,9 +1151,12 @@ try
     if (Backend::is_map(value))
     {
         const auto* reserved_names = reserved_field_names<Reflectable>();
+        field_lookup<Backend, Reflectable> lookup{value};
 
-        ctti::reflect_object(out, [&value, &reserved_names, &ctx](auto field) {
+        ctti::reflect_object(out, [&value, &reserved_names, &lookup, &ctx,
+                                   index = std::size_t{0}](auto field) mutable {
             check_field_attributes<decltype(field)>();
+            const std::size_t field_index = index++;
 
             if constexpr (!has_attribute<attributes::skip_deserialization_t>(field))
             {
@@ -956,8 +1201,8 @@ try
                         return;
                     }
 
-                    const char* name = resolve_field_name<Backend>(value, field);
-                    if (!name)
+                    const auto* node = lookup.find(field, field_index);
+                    if (!node)
                     {
                         if (apply_missing_field_policy(field))
                             return;
@@ -969,11 +1214,10 @@ try
                         return;
                     }
 
-                    const auto& node = Backend::at_field(value, name);
                     // If the node exists but is null and we also need to apply a default value.
-                    if (Backend::is_null(node) && apply_null_field_policy(field))
+                    if (Backend::is_null(*node) && apply_null_field_policy(field))
                         return;
-                    Backend::deserialize(field.value(), node, ctx);
+                    Backend::deserialize(field.value(), *node, ctx);
                     validate_field(field);
                 }
                 catch (deserialize_error& ex)
@@ -993,7 +1237,8 @@ try
             throw deserialize_error{"sequence size is greater than declared struct's field count"};
         }
 
-        ctti::reflect_object(out, [&value, &ctx, index = 0U](auto field) mutable {
+        sequence_cursor_t<Backend> elements{value};
+        ctti::reflect_object(out, [&elements, &ctx, index = 0U](auto field) mutable {
             check_field_attributes<decltype(field)>();
 
             if constexpr (!has_attribute<attributes::skip_deserialization_t>(field))
@@ -1011,7 +1256,7 @@ try
                             "flatten fields are not supported in sequence deserialization"};
                     }
 
-                    Backend::deserialize(field.value(), Backend::at_index(value, index), ctx);
+                    Backend::deserialize(field.value(), elements.next(), ctx);
                     validate_field(field);
                     ++index;
                 }
@@ -1081,7 +1326,9 @@ template <typename Backend, typename Tuple, typename Context, std::size_t... Is>
 void deserialize_tuple(Tuple& out, const typename Backend::value_type& value,
                        Context& ctx, std::index_sequence<Is...>)
 {
-    (Backend::deserialize(std::get<Is>(out), Backend::at_index(value, Is), ctx), ...);
+    // The comma fold evaluates left to right so elements come in order
+    [[maybe_unused]] sequence_cursor_t<Backend> elements{value};
+    (Backend::deserialize(std::get<Is>(out), elements.next(), ctx), ...);
 }
 
 } // namespace impl
@@ -1117,6 +1364,367 @@ void deserialize_adl(std::optional<T>& out, const typename Backend::value_type&
     out = std::move(element);
 }
 
+// try_deserialize_adl implementation. Mirrors deserialize_adl but failures are
+// recorded in deserialize_status and reported by returning false.
+
+template <typename Field>
+bool try_validate_field(const Field& field, deserialize_status& status)
+{
+    // Validators are user code and report errors by throwing
+    try
+    {
+        validate_field(field);
+        return true;
+    }
+    catch (deserialize_error& ex)
+    {
+        status.fail(std::string{ex.what()});
+        return false;
+    }
+}
+
+template <typename Backend, typename Key, typename Context>
+std::string field_key_name(const Key& key, Context& ctx)
+{
+    if constexpr (has_field_key_v<Backend>)
+    {
+        (void)ctx;
+        return std::string{Backend::field_key(key)};
+    }
+    else
+    {
+        deserialize_status ignored;
+        std::string name;
+        Backend::try_deserialize(name, key, ctx, ignored);
+        return name;
+    }
+}
+
+template <typename Backend, typename Map, typename Context,
+          enable_if<::kl::detail::is_map_alike<Map>> = true>
+bool try_deserialize_adl(Map& out, const typename Backend::value_type& value, Context& ctx,
+                         deserialize_status& status)
+{
+    if (!Backend::try_expect_map(value, status))
+        return false;
+
+    out.clear();
+
+    bool ok = true;
+    Backend::for_each_field(value, [&](const auto& key, const auto& field) {
+        if (!ok)
+            return;
+
+        typename Map::key_type key_value{};
+        typename Map::mapped_type mapped_value{};
+        ok = Backend::try_deserialize(key_value, key, ctx, status) &&
+             Backend::try_deserialize(mapped_value, field, ctx, status);
+        if (ok)
+            out.emplace(std::move(key_value), std::move(mapped_value));
+        else
+            status.add_field(field_key_name<Backend>(key, ctx));
+    });
+    return ok;
+}
+
+template <typename Backend, typename GrowableRange, typename Context,
+          enable_if<std::negation<::kl::detail::is_map_alike<GrowableRange>>,
+                    ::kl::detail::is_growable_range<GrowableRange>> = true>
+bool try_deserialize_adl(GrowableRange& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    if (!Backend::try_expect_sequence(value, status))
+        return false;
+
+    out.clear();
+    if constexpr (::kl::detail::has_reserve_v<GrowableRange>)
+        out.reserve(Backend::size(value));
+
+    bool ok = true;
+    Backend::for_each_element(value, [&](const auto& item) {
+        if (!ok)
+            return;
+
+        typename GrowableRange::value_type element{};
+        ok = Backend::try_deserialize(element, item, ctx, status);
+        if (ok)
+            out.push_back(std::move(element));
+        else
+            status.add_element(out.size());
+    });
+    return ok;
+}
+
+template <typename Backend, typename FixedSizeRange, typename Context,
+          enable_if<std::negation<::kl::detail::is_map_alike<FixedSizeRange>>,
+                    ::kl::detail::is_fixed_size_range<FixedSizeRange>> = true>
+bool try_deserialize_adl(FixedSizeRange& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    if (!Backend::try_expect_sequence(value, status))
+        return false;
+    if (out.size() < Backend::size(value))
+    {
+        status.fail("sequence size is greater than declared range field count");
+        return false;
+    }
+
+    sequence_cursor_t<Backend> elements{value};
+    std::size_t index = 0;
+    for (auto& element : out)
+    {
+        if (!Backend::try_deserialize(element, elements.next(), ctx, status))
+        {
+            status.add_element(index);
+            return false;
+        }
+        ++index;
+    }
+    return true;
+}
+
+template <typename Backend, typename Reflectable, typename Context,
+          enable_if<ctti::is_reflectable<Reflectable>> = true>
+bool try_deserialize_adl(Reflectable& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    static_assert(deserialize_field_names_validator<Reflectable>::validate(),
+                  "reflected deserialization field name collision (duplicate canonical name)");
+
+    bool ok = true;
+    if (Backend::is_map(value))
+    {
+        const auto* reserved_names = reserved_field_names<Reflectable>();
+        field_lookup<Backend, Reflectable> lookup{value};
+
+        ctti::reflect_object(out, [&, index = std::size_t{0}](auto field) mutable {
+            check_field_attributes<decltype(field)>();
+            const std::size_t field_index = index++;
+
+            if constexpr (!has_attribute<attributes::skip_deserialization_t>(field))
+            {
+                using Field = decltype(field);
+                if (!ok)
+                    return;
+
+                if constexpr (Field::template has<attributes::extra_fields_t>())
+                {
+                    assert(reserved_names);
+                    auto& extras = field.value();
+                    extras.clear();
+
+                    Backend::for_each_field(value, [&](const auto& key, const auto& node) {
+                        if (!ok)
+                            return;
+
+                        std::string key_value;
+                        if (!Backend::try_deserialize(key_value, key, ctx, status))
+                        {
+                            ok = false;
+                            status.add_extra_field("key");
+                            return;
+                        }
+                        if (reserved_names->find(key_value) != reserved_names->end())
+                            return;
+
+                        typename remove_cvref_t<decltype(extras)>::mapped_type mapped_value{};
+                        if (!Backend::try_deserialize(mapped_value, node, ctx, status))
+                        {
+                            ok = false;
+                            status.add_extra_field(std::move(key_value));
+                            return;
+                        }
+                        extras.emplace(std::move(key_value), std::move(mapped_value));
+                    });
+                }
+                else if constexpr (Field::template has<attributes::flatten_t>())
+                {
+                    ok = Backend::try_deserialize(field.value(), value, ctx, status);
+                }
+                else if (const auto* node = lookup.find(field, field_index); !node)
+                {
+                    if (!apply_missing_field_policy(field))
+                    {
+                        ok = Backend::try_deserialize(
+                                 field.value(), Backend::at_field(value, serialized_name(field)),
+                                 ctx, status) &&
+                             try_validate_field(field, status);
+                    }
+                }
+                // If the node exists but is null and we also need to apply a default value.
+                else if (!Backend::is_null(*node) || !apply_null_field_policy(field))
+                {
+                    ok = Backend::try_deserialize(field.value(), *node, ctx, status) &&
+                         try_validate_field(field, status);
+                }
+
+                if constexpr (!Field::template has<attributes::extra_fields_t>())
+                {
+                    if (!ok)
+                        status.add_field(field.name());
+                }
+            }
+        });
+    }
+    else if (Backend::is_sequence(value))
+    {
+        constexpr auto max_sequence_size = sequence_deserializable_field_count<Reflectable>();
+        if (max_sequence_size < Backend::size(value))
+        {
+            status.fail("sequence size is greater than declared struct's field count");
+            ok = false;
+        }
+        else
+        {
+            sequence_cursor_t<Backend> elements{value};
+            ctti::reflect_object(out, [&, index = 0U](auto field) mutable {
+                check_field_attributes<decltype(field)>();
+
+                if constexpr (!has_attribute<attributes::skip_deserialization_t>(field))
+                {
+                    if (!ok)
+                        return;
+
+                    if constexpr (decltype(field)::template has<attributes::extra_fields_t>())
+                    {
+                        status.fail(
+                            "extra_fields fields are not supported in sequence deserialization");
+                        ok = false;
+                    }
+                    else if constexpr (decltype(field)::template has<attributes::flatten_t>())
+                    {
+                        status.fail("flatten fields are not supported in sequence deserialization");
+                        ok = false;
+                    }
+                    else
+                    {
+                        ok = Backend::try_deserialize(field.value(), elements.next(), ctx,
+                                                      status) &&
+                             try_validate_field(field, status);
+                    }
+
+                    if (!ok)
+                        status.add_element(index);
+                    ++index;
+                }
+            });
+        }
+    }
+    else
+    {
+        status.fail("type must be a sequence or map but is a " + Backend::type_name(value));
+        ok = false;
+    }
+
+    if (!ok)
+        status.add_type(typeid(Reflectable));
+    return ok;
+}
+
+template <typename Backend, typename Enum, typename Context,
+          enable_if<std::is_enum<Enum>> = true>
+bool try_deserialize_adl(Enum& out, const typename Backend::value_type& value, Context& ctx,
+                         deserialize_status& status)
+{
+    if constexpr (is_enum_reflectable_v<Enum>)
+    {
+        std::string text;
+        if (!Backend::try_deserialize(text, value, ctx, status))
+            return false;
+        if (auto enum_value = kl::from_string<Enum>(text))
+        {
+            out = *enum_value;
+            return true;
+        }
+
+        status.fail("invalid enum value: " + text);
+        return false;
+    }
+    else
+    {
+        std::underlying_type_t<Enum> underlying_value{};
+        if (!Backend::try_deserialize(underlying_value, value, ctx, status))
+            return false;
+        out = static_cast<Enum>(underlying_value);
+        return true;
+    }
+}
+
+template <typename Backend, typename Enum, typename Context>
+bool try_deserialize_adl(enum_set<Enum>& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    if (!Backend::try_expect_sequence(value, status))
+        return false;
+    out = {};
+
+    bool ok = true;
+    Backend::for_each_element(value, [&](const auto& item) {
+        Enum e{};
+        if (ok && (ok = Backend::try_deserialize(e, item, ctx, status)))
+            out |= e;
+    });
+    return ok;
+}
+
+namespace impl {
+
+template <typename Backend, typename Tuple, typename Context, std::size_t... Is>
+bool try_deserialize_tuple(Tuple& out, const typename Backend::value_type& value, Context& ctx,
+                           deserialize_status& status, std::index_sequence<Is...>)
+{
+    [[maybe_unused]] sequence_cursor_t<Backend> elements{value};
+    return (Backend::try_deserialize(std::get<Is>(out), elements.next(), ctx, status) && ...);
+}
+
+} // namespace impl
+
+template <typename Backend, typename Context, typename... Ts>
+bool try_deserialize_adl(std::tuple<Ts...>& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    if (!Backend::try_expect_sequence(value, status))
+        return false;
+    if (sizeof...(Ts) < Backend::size(value))
+    {
+        status.fail("sequence size is greater than declared tuple field count");
+        return false;
+    }
+    return impl::try_deserialize_tuple<Backend>(out, value, ctx, status,
+                                                std::make_index_sequence<sizeof...(Ts)>{});
+}
+
+template <typename Backend, typename Context, typename T, typename U>
+bool try_deserialize_adl(std::pair<T, U>& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    if (!Backend::try_expect_sequence(value, status))
+        return false;
+    if (2 < Backend::size(value))
+    {
+        status.fail("sequence size is greater than pair field count");
+        return false;
+    }
+    return impl::try_deserialize_tuple<Backend>(out, value, ctx, status,
+                                                std::make_index_sequence<2>{});
+}
+
+template <typename Backend, typename T, typename Context>
+bool try_deserialize_adl(std::optional<T>& out, const typename Backend::value_type& value,
+                         Context& ctx, deserialize_status& status)
+{
+    if (Backend::is_null(value))
+    {
+        out.reset();
+        return true;
+    }
+    T element{};
+    if (!Backend::try_deserialize(element, value, ctx, status))
+        return false;
+    out = std::move(element);
+    return true;
+}
+
 // patch_adl implementation
 
 template <typename Backend, typename Reflectable, typename Context,
@@ -1136,9 +1744,12 @@ try
     }
 
     const auto* reserved_names = reserved_field_names<Reflectable>();
+    field_lookup<Backend, Reflectable> lookup{value};
 
-    ctti::reflect_object(out, [&value, &reserved_names, &ctx](auto field) {
+    ctti::reflect_object(out, [&value, &reserved_names, &lookup, &ctx,
+                               index = std::size_t{0}](auto field) mutable {
         check_field_attributes<decltype(field)>();
+        const std::size_t field_index = index++;
 
         if constexpr (!has_attribute<attributes::skip_deserialization_t>(field))
         {
@@ -1192,14 +1803,13 @@ try
                     return;
                 }
 
-                const char* name = resolve_field_name<Backend>(value, field);
-                if (!name)
+                const auto* node = lookup.find(field, field_index);
+                if (!node)
                     return;
 
-                const auto& node = Backend::at_field(value, name);
-                if (Backend::is_null(node) && apply_null_field_policy(field))
+                if (Backend::is_null(*node) && apply_null_field_policy(field))
                     return;
-                Backend::patch(field.value(), node, ctx);
+                Backend::patch(field.value(), *node, ctx);
                 validate_field(field);
             }
             catch (deserialize_error& ex)
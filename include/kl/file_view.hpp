@@ -6,14 +6,46 @@
 
 namespace kl {
 
+enum class file_access
+{
+    // Default read-ahead
+    normal,
+    // Read mostly front to back, the OS reads ahead more aggressively and may
+    // drop pages once they've been passed
+    sequential,
+    // Read in no particular order, read-ahead is disabled
+    random
+};
+
+// Hints on how the mapped file is going to be read. Besides `lock` they are
+// best-effort and silently ignored where the OS or filesystem doesn't support
+// them.
+struct file_view_options
+{
+    file_access access = file_access::normal;
+    // Read the whole file in up-front instead of page faulting on first touch
+    bool populate = false;
+    // Back the mapping with (transparent) huge pages to save on page faults
+    // and TLB misses when scanning big files
+    bool huge_pages = false;
+    // Keep the file resident in memory. Throws if the pages can't be locked,
+    // e.g. because of RLIMIT_MEMLOCK.
+    bool lock = false;
+};
+
 class file_view
 {
 public:
-    explicit file_view(const char* file_path);
+    explicit file_view(const char* file_path, const file_view_options& opts = {});
     ~file_view();
 
     gsl::span<const std::byte> get_bytes() const noexcept { return contents_; }
 
+    // Starts reading given range in the background so that it's resident by
+    // the time it's accessed. Meant to be issued ahead of a streaming
+    // consumer. The range is clamped to the file's size.
+    void prefetch(std::size_t offset, std::size_t length) const noexcept;
+
 private:
     gsl::span<const std::byte> contents_;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "kl/defer.hpp"
 #include "kl/json_fwd.hpp"
 #include "kl/serialization.hpp"
 #include "kl/serialization_error.hpp"
@@ -15,16 +16,29 @@
 #include <rapidjson/document.h>
 #include <rapidjson/error/error.h>
 #include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <gsl/span>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace kl::json {
 
@@ -79,6 +93,235 @@ private:
     bool skip_null_fields_;
 };
 
+// Reusable memory for parse -> deserialize -> serialize -> dump cycles. Parsed
+// documents, serialized values and the parser's stack are carved out of two
+// retained blocks while the dumped text lands in a retained string buffer.
+// Everything handed out by the arena stays valid until the next reset(). If a
+// cycle spilled over a block, reset() regrows it to fit so that, once warmed
+// up, parsing, serializing and dumping with the arena don't touch the heap.
+// Deserialization still allocates whatever the output objects need: elements
+// of containers are constructed anew, along with their own strings and
+// containers.
+class arena
+{
+public:
+    using document_type =
+        rapidjson::GenericDocument<rapidjson::UTF8<>, json::allocator, json::allocator>;
+    using writer_type = rapidjson::Writer<rapidjson::StringBuffer>;
+
+    explicit arena(std::size_t capacity = json::allocator::kDefaultChunkCapacity);
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    json::allocator& allocator() { return *values_.alloc; }
+    document_type& document() { return *doc_; }
+
+    // Returns a writer over the cleared string buffer
+    writer_type& writer();
+    std::string_view text() const { return {buffer_.GetString(), buffer_.GetSize()}; }
+
+    // Invalidates all values, documents and text obtained from the arena
+    void reset();
+
+    // Bytes retained by the arena (not counting the string buffer)
+    std::size_t capacity() const { return values_.size + stack_.size; }
+
+private:
+    struct pool
+    {
+        explicit pool(std::size_t capacity);
+
+        bool clear();
+
+        std::unique_ptr<char[]> block;
+        std::size_t size;
+        std::size_t usable;
+        std::optional<json::allocator> alloc;
+    };
+
+    void make_document();
+
+private:
+    pool values_;
+    pool stack_;
+    std::optional<document_type> doc_;
+    rapidjson::StringBuffer buffer_;
+    writer_type writer_;
+};
+
+namespace detail {
+
+inline constexpr char digit_pairs[] = "0001020304050607080910111213141516171819"
+                                      "2021222324252627282930313233343536373839"
+                                      "4041424344454647484950515253545556575859"
+                                      "6061626364656667686970717273747576777879"
+                                      "8081828384858687888990919293949596979899";
+
+// Writes the decimal digits of `u` right-aligned at `last` (two at a time),
+// returns pointer to the first one
+inline char* format_decimal(std::uint64_t u, char* last)
+{
+    while (u >= 100)
+    {
+        const auto i = static_cast<std::size_t>(u % 100) * 2;
+        u /= 100;
+        last -= 2;
+        last[0] = digit_pairs[i];
+        last[1] = digit_pairs[i + 1];
+    }
+    if (u < 10)
+    {
+        *--last = static_cast<char>('0' + u);
+    }
+    else
+    {
+        const auto i = static_cast<std::size_t>(u) * 2;
+        last -= 2;
+        last[0] = digit_pairs[i];
+        last[1] = digit_pairs[i + 1];
+    }
+    return last;
+}
+} // namespace detail
+
+// Writer (rapidjson Handler) appending JSON text straight into a std::string.
+// Can be used in place of rapidjson::Writer with dump_context and produces the
+// same output for everything but floating point numbers: these are formatted
+// with std::to_chars as the shortest text which round-trips (exponent, if
+// any, is written as "1e+21"). Integers are formatted two digits at a time.
+class string_writer
+{
+public:
+    using Ch = char;
+
+    explicit string_writer(std::size_t capacity = 256) { buffer_.reserve(capacity); }
+
+    bool Null() { return prefix(), append("null", 4); }
+    bool Bool(bool b) { return prefix(), b ? append("true", 4) : append("false", 5); }
+    bool Int(int i) { return Int64(i); }
+    bool Uint(unsigned u) { return Uint64(u); }
+
+    bool Int64(std::int64_t i)
+    {
+        prefix();
+        char buf[20];
+        const auto u = static_cast<std::uint64_t>(i);
+        char* first = detail::format_decimal(i < 0 ? ~u + 1 : u, std::end(buf));
+        if (i < 0)
+            *--first = '-';
+        return append(first, static_cast<std::size_t>(std::end(buf) - first));
+    }
+
+    bool Uint64(std::uint64_t u)
+    {
+        prefix();
+        char buf[20];
+        const char* first = detail::format_decimal(u, std::end(buf));
+        return append(first, static_cast<std::size_t>(std::end(buf) - first));
+    }
+
+    // NaN and infinities are rejected, same as with rapidjson::Writer
+    bool Double(double d);
+
+    bool RawNumber(const Ch* str, rapidjson::SizeType length, bool = false)
+    {
+        return prefix(), append(str, length);
+    }
+
+    bool String(const Ch* str, rapidjson::SizeType length, bool = false)
+    {
+        prefix();
+        write_string(str, length);
+        return true;
+    }
+    bool String(const Ch* str) { return String(str, length_of(str)); }
+    bool String(const std::string& str)
+    {
+        return String(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+    }
+
+    bool StartObject() { return prefix(), push(false, '{'); }
+    bool Key(const Ch* str, rapidjson::SizeType length, bool copy = false)
+    {
+        return String(str, length, copy);
+    }
+    bool Key(const Ch* str) { return String(str); }
+    bool EndObject(rapidjson::SizeType = 0) { return pop('}'); }
+
+    bool StartArray() { return prefix(), push(true, '['); }
+    bool EndArray(rapidjson::SizeType = 0) { return pop(']'); }
+
+    // Writes already formatted JSON value (e.g. quoted field key)
+    bool RawValue(const Ch* json, std::size_t length, rapidjson::Type)
+    {
+        return prefix(), append(json, length);
+    }
+
+    bool IsComplete() const { return has_root_ && levels_.empty(); }
+
+    std::string_view str() const { return buffer_; }
+    // Moves the text out, leaving the writer empty
+    std::string release();
+    // Starts over, keeping the buffer's capacity
+    void Reset();
+
+private:
+    struct level
+    {
+        std::size_t count;
+        bool in_array;
+    };
+
+    static rapidjson::SizeType length_of(const Ch* str)
+    {
+        return static_cast<rapidjson::SizeType>(std::char_traits<Ch>::length(str));
+    }
+
+    // Puts the separator the next value needs
+    void prefix()
+    {
+        if (levels_.empty())
+        {
+            has_root_ = true;
+            return;
+        }
+
+        auto& top = levels_.back();
+        if (top.count > 0)
+            buffer_.push_back(top.in_array || top.count % 2 == 0 ? ',' : ':');
+        ++top.count;
+    }
+
+    bool append(const Ch* str, std::size_t length)
+    {
+        buffer_.append(str, length);
+        return true;
+    }
+
+    bool push(bool in_array, Ch bracket)
+    {
+        levels_.push_back({0, in_array});
+        buffer_.push_back(bracket);
+        return true;
+    }
+
+    bool pop(Ch bracket)
+    {
+        assert(!levels_.empty());
+        levels_.pop_back();
+        buffer_.push_back(bracket);
+        return true;
+    }
+
+    void write_string(const Ch* str, std::size_t length);
+
+private:
+    std::string buffer_;
+    std::vector<level> levels_;
+    bool has_root_{false};
+};
+
 class owning_serialize_context : public tree_tag
 {
 public:
@@ -109,6 +352,12 @@ public:
     {
     }
 
+    explicit serialize_context(json::arena& arena,
+                               bool skip_null_fields = true)
+        : serialize_context{arena.allocator(), skip_null_fields}
+    {
+    }
+
     explicit serialize_context(json::allocator& alloc,
                                bool skip_null_fields = true)
         : alloc_{alloc}, skip_null_fields_{skip_null_fields}
@@ -132,6 +381,49 @@ class deserialize_context : public tree_tag
 {
 };
 
+// Deserialize context which splits large JSON arrays being deserialized into
+// std::vector across worker threads, each filling its own disjoint index range
+// of the pre-sized vector. Only the outermost such array is split, nested ones
+// are deserialized sequentially by the workers. Everything else in
+// deserialize_context applies as is, including the errors reported.
+//
+// All workers share the same context object and call the element type's
+// deserialize/deserialize_adl overloads concurrently. A context derived from
+// this one must therefore be safe to use from several threads at once, and so
+// must any user-provided overloads reached from the elements.
+class parallel_deserialize_context : public deserialize_context
+{
+public:
+    // num_threads of 0 means std::thread::hardware_concurrency()
+    explicit parallel_deserialize_context(unsigned num_threads = 0,
+                                          std::size_t min_parallel_size = 1024)
+        : num_threads_{num_threads ? num_threads
+                                   : std::max(std::thread::hardware_concurrency(), 1u)},
+          min_parallel_size_{min_parallel_size}
+    {
+    }
+
+    unsigned num_threads() const { return num_threads_; }
+    std::size_t min_parallel_size() const { return min_parallel_size_; }
+
+    // Returns true if array of given size should be split (and thus the
+    // parallel region was entered)
+    bool enter_parallel(std::size_t size)
+    {
+        if (in_parallel_ || num_threads_ < 2 || size < min_parallel_size_)
+            return false;
+        in_parallel_ = true;
+        return true;
+    }
+
+    void leave_parallel() { in_parallel_ = false; }
+
+private:
+    unsigned num_threads_;
+    std::size_t min_parallel_size_;
+    bool in_parallel_{false};
+};
+
 namespace detail {
 
 inline const rapidjson::Value& get_null_value()
@@ -146,6 +438,14 @@ void expect_boolean(const rapidjson::Value& value);
 void expect_string(const rapidjson::Value& value);
 void expect_object(const rapidjson::Value& value);
 void expect_array(const rapidjson::Value& value);
+
+// Non-throwing counterparts of the above, used by try_deserialize()
+bool check_integral(const rapidjson::Value& value, serialization::deserialize_status& status);
+bool check_number(const rapidjson::Value& value, serialization::deserialize_status& status);
+bool check_boolean(const rapidjson::Value& value, serialization::deserialize_status& status);
+bool check_string(const rapidjson::Value& value, serialization::deserialize_status& status);
+bool check_object(const rapidjson::Value& value, serialization::deserialize_status& status);
+bool check_array(const rapidjson::Value& value, serialization::deserialize_status& status);
 } // namespace detail
 
 // Safely gets the JSON value from the JSON array. If provided index is
@@ -353,6 +653,155 @@ namespace detail {
 
 std::string type_name(const rapidjson::Value& value);
 
+// Length of the string once quoted and escaped the way rapidjson::Writer does it
+constexpr std::size_t quoted_length(const char* str)
+{
+    std::size_t n = 2;
+    for (; *str; ++str)
+    {
+        const auto c = static_cast<unsigned char>(*str);
+        if (c == '"' || c == '\\' || c == '\b' || c == '\f' || c == '\n' || c == '\r' ||
+            c == '\t')
+            n += 2;
+        else if (c < 0x20)
+            n += 6;
+        else
+            n += 1;
+    }
+    return n;
+}
+
+constexpr bool is_ascii(const char* str)
+{
+    for (; *str; ++str)
+    {
+        if (static_cast<unsigned char>(*str) >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+template <typename Output>
+constexpr std::size_t write_quoted(const char* str, Output& out, std::size_t pos)
+{
+    constexpr char hex_digits[] = "0123456789ABCDEF";
+
+    out[pos++] = '"';
+    for (; *str; ++str)
+    {
+        const auto c = static_cast<unsigned char>(*str);
+        char short_escape = 0;
+        switch (c)
+        {
+        case '"': short_escape = '"'; break;
+        case '\\': short_escape = '\\'; break;
+        case '\b': short_escape = 'b'; break;
+        case '\f': short_escape = 'f'; break;
+        case '\n': short_escape = 'n'; break;
+        case '\r': short_escape = 'r'; break;
+        case '\t': short_escape = 't'; break;
+        default: break;
+        }
+
+        if (short_escape)
+        {
+            out[pos++] = '\\';
+            out[pos++] = short_escape;
+        }
+        else if (c < 0x20)
+        {
+            out[pos++] = '\\';
+            out[pos++] = 'u';
+            out[pos++] = '0';
+            out[pos++] = '0';
+            out[pos++] = hex_digits[c >> 4];
+            out[pos++] = hex_digits[c & 0xF];
+        }
+        else
+        {
+            out[pos++] = static_cast<char>(c);
+        }
+    }
+    out[pos++] = '"';
+    return pos;
+}
+
+template <typename Field>
+constexpr bool is_dumped_by_name()
+{
+    return !Field::template has<serialization::attributes::skip_serialization_t>() &&
+           !Field::template has<serialization::attributes::extra_fields_t>() &&
+           !Field::template has<serialization::attributes::flatten_t>();
+}
+
+template <typename Reflectable>
+constexpr std::size_t reflected_field_count()
+{
+    std::size_t n = 0;
+    ctti::reflect_type<Reflectable, serialization::detail::validator_attribute_filter>(
+        [&n](auto) { ++n; });
+    return n;
+}
+
+template <typename Reflectable>
+constexpr std::size_t quoted_field_keys_length()
+{
+    std::size_t n = 0;
+    ctti::reflect_type<Reflectable, serialization::detail::validator_attribute_filter>(
+        [&n](auto field) {
+            if constexpr (is_dumped_by_name<decltype(field)>())
+                n += quoted_length(serialization::detail::serialized_name(field));
+        });
+    return n;
+}
+
+template <typename Reflectable>
+struct quoted_field_keys_data
+{
+    std::array<char, quoted_field_keys_length<Reflectable>()> chars{};
+    // Key of the I-th field spans [offsets[I], offsets[I + 1])
+    std::array<std::size_t, reflected_field_count<Reflectable>() + 1> offsets{};
+    // Non-ASCII keys might need transcoding so they can't be written raw
+    bool ascii = true;
+};
+
+template <typename Reflectable>
+constexpr auto make_quoted_field_keys()
+{
+    quoted_field_keys_data<Reflectable> data{};
+    std::size_t pos = 0;
+    std::size_t index = 0;
+
+    ctti::reflect_type<Reflectable, serialization::detail::validator_attribute_filter>(
+        [&](auto field) {
+            data.offsets[index++] = pos;
+            if constexpr (is_dumped_by_name<decltype(field)>())
+            {
+                const char* name = serialization::detail::serialized_name(field);
+                data.ascii = data.ascii && is_ascii(name);
+                pos = write_quoted(name, data.chars, pos);
+            }
+        });
+    data.offsets[index] = pos;
+    return data;
+}
+
+// Compile-time table of quoted and escaped keys of Reflectable's fields, ready
+// to be copied verbatim into the output
+template <typename Reflectable>
+struct quoted_field_keys
+{
+    static constexpr auto data = make_quoted_field_keys<Reflectable>();
+
+    static std::string_view get(std::size_t index) noexcept
+    {
+        return {data.chars.data() + data.offsets[index],
+                data.offsets[index + 1] - data.offsets[index]};
+    }
+};
+
+KL_VALID_EXPR_HELPER(has_raw_value, std::declval<T&>().RawValue("", 0, rapidjson::kStringType))
+
 struct json_stream_backend
 {
     // Trampoline from the kl::serialization back to json "world"
@@ -382,6 +831,26 @@ struct json_stream_backend
         write_key_impl(key, ctx);
     }
 
+    // Reflected field names are known at compile time so if the writer lets
+    // us, skip escaping them over and over again and write them as is
+    template <typename Reflectable, typename Context>
+    static void write_field_key(serialization::detail::reflected_field_key<Reflectable> key,
+                                Context& ctx)
+    {
+        using writer_type = std::remove_reference_t<decltype(ctx.writer())>;
+        using keys = quoted_field_keys<Reflectable>;
+
+        if constexpr (has_raw_value_v<writer_type> && keys::data.ascii)
+        {
+            const auto quoted = keys::get(key.index);
+            ctx.writer().RawValue(quoted.data(), quoted.size(), rapidjson::kStringType);
+        }
+        else
+        {
+            write_key_impl(key.name, ctx);
+        }
+    }
+
     // Sequence stuff
 
     template <typename Context>
@@ -434,10 +903,22 @@ struct json_tree_backend
         serialization::detail::patch_with_backend<json::tree_tag>(out, value, ctx);
     }
 
+    template <typename T, typename Context>
+    static bool try_deserialize(T& out, const value_type& value, Context& ctx,
+                                serialization::deserialize_status& status)
+    {
+        return serialization::detail::try_deserialize_with_backend<json::tree_tag>(out, value,
+                                                                                  ctx, status);
+    }
+
     // Map stuff
 
     static value_type make_map() { return value_type{rapidjson::kObjectType}; }
     static void expect_map(const value_type& value) { detail::expect_object(value); }
+    static bool try_expect_map(const value_type& value, serialization::deserialize_status& status)
+    {
+        return detail::check_object(value, status);
+    }
     static bool is_map(const value_type& value) { return value.IsObject(); }
 
     template <typename Context>
@@ -463,10 +944,20 @@ struct json_tree_backend
             visitor(obj.name, obj.value);
     }
 
+    static std::string_view field_key(const value_type& key)
+    {
+        return {key.GetString(), key.GetStringLength()};
+    }
+
     // Sequence stuff
 
     static value_type make_sequence() { return value_type{rapidjson::kArrayType}; }
     static void expect_sequence(const value_type& value) { detail::expect_array(value); }
+    static bool try_expect_sequence(const value_type& value,
+                                    serialization::deserialize_status& status)
+    {
+        return detail::check_array(value, status);
+    }
     static bool is_sequence(const value_type& value) { return value.IsArray(); }
 
     template <typename Context>
@@ -525,6 +1016,18 @@ Target narrow(Source src)
     return static_cast<Target>(src);
 }
 
+template <typename Target, typename Source>
+bool try_narrow(Source src, Target& out, serialization::deserialize_status& status)
+{
+    if (static_cast<Source>(static_cast<Target>(src)) != src)
+    {
+        status.fail("value cannot be losslessly stored in the variable");
+        return false;
+    }
+    out = static_cast<Target>(src);
+    return true;
+}
+
 } // namespace detail
 } // namespace kl::json
 
@@ -740,7 +1243,8 @@ template <typename Context>
 void deserialize_adl(json::tree_tag, std::string& out, const rapidjson::Value& value, Context&)
 {
     json::detail::expect_string(value);
-    out = {value.GetString(), static_cast<std::size_t>(value.GetStringLength())};
+    // Reuse whatever capacity `out` already has
+    out.assign(value.GetString(), static_cast<std::size_t>(value.GetStringLength()));
 }
 
 template <typename Context>
@@ -761,6 +1265,164 @@ void deserialize_adl(json::tree_tag, json::view& out, const rapidjson::Value& va
     out = json::view{value};
 }
 
+// try_deserialize_adl implementations for simple types
+
+template <typename Integral, typename Context, enable_if<std::is_integral<Integral>> = true>
+bool try_deserialize_adl(json::tree_tag, Integral& out, const rapidjson::Value& value, Context&,
+                         deserialize_status& status)
+{
+    if (!json::detail::check_integral(value, status))
+        return false;
+
+    if constexpr (std::is_signed_v<Integral> && sizeof(Integral) < 8)
+    {
+        if (value.IsInt())
+            return json::detail::try_narrow(value.GetInt(), out, status);
+    }
+    else if constexpr (std::is_signed_v<Integral> && sizeof(Integral) == 8)
+    {
+        if (value.IsInt64())
+        {
+            out = value.GetInt64();
+            return true;
+        }
+    }
+    else if constexpr (std::is_unsigned_v<Integral> && sizeof(Integral) < 8)
+    {
+        if (value.IsUint())
+            return json::detail::try_narrow(value.GetUint(), out, status);
+    }
+    else if constexpr (std::is_unsigned_v<Integral> && sizeof(Integral) == 8)
+    {
+        if (value.IsUint64())
+        {
+            out = value.GetUint64();
+            return true;
+        }
+    }
+    status.fail("value cannot be losslessly stored in the variable");
+    return false;
+}
+
+template <typename Floating, typename Context, enable_if<std::is_floating_point<Floating>> = true>
+bool try_deserialize_adl(json::tree_tag, Floating& out, const rapidjson::Value& value, Context&,
+                         deserialize_status& status)
+{
+    if (!json::detail::check_number(value, status))
+        return false;
+    out = static_cast<Floating>(value.GetDouble());
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(json::tree_tag, bool& out, const rapidjson::Value& value, Context&,
+                         deserialize_status& status)
+{
+    if (!json::detail::check_boolean(value, status))
+        return false;
+    out = value.GetBool();
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(json::tree_tag, std::string& out, const rapidjson::Value& value,
+                         Context&, deserialize_status& status)
+{
+    if (!json::detail::check_string(value, status))
+        return false;
+    out.assign(value.GetString(), static_cast<std::size_t>(value.GetStringLength()));
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(json::tree_tag, std::string_view& out, const rapidjson::Value& value,
+                         Context&, deserialize_status& status)
+{
+    if (!json::detail::check_string(value, status))
+        return false;
+    out = {value.GetString(), static_cast<std::size_t>(value.GetStringLength())};
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(json::tree_tag, json::view& out, const rapidjson::Value& value,
+                         Context&, deserialize_status&)
+{
+    out = json::view{value};
+    return true;
+}
+
+template <typename T, typename Allocator, typename Context,
+          enable_if<std::is_base_of<json::parallel_deserialize_context, Context>,
+                    std::negation<std::is_same<T, bool>>> = true>
+void deserialize_adl(json::tree_tag, std::vector<T, Allocator>& out,
+                     const rapidjson::Value& value, Context& ctx)
+{
+    json::detail::expect_array(value);
+    const auto size = static_cast<std::size_t>(value.Size());
+    if (!ctx.enter_parallel(size))
+    {
+        detail::deserialize_adl<json::detail::json_tree_backend>(out, value, ctx);
+        return;
+    }
+
+    KL_DEFER(ctx.leave_parallel());
+
+    out.clear();
+    out.resize(size);
+
+    const auto num_threads = std::min<std::size_t>(ctx.num_threads(), size);
+    const auto per_thread = (size + num_threads - 1) / num_threads;
+
+    // First failure of each index range, ranges are in order so the first
+    // recorded error is also the one with the lowest index
+    std::vector<std::pair<std::size_t, std::exception_ptr>> errors(num_threads);
+    auto deserialize_range = [&](std::size_t range) {
+        const auto first = range * per_thread;
+        const auto last = std::min(first + per_thread, size);
+        for (auto index = first; index < last; ++index)
+        {
+            try
+            {
+                json::deserialize(out[index], value[static_cast<rapidjson::SizeType>(index)],
+                                  ctx);
+            }
+            catch (...)
+            {
+                errors[range] = {index, std::current_exception()};
+                return;
+            }
+        }
+    };
+
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads - 1);
+        KL_DEFER(for (auto& worker : workers) worker.join());
+
+        for (std::size_t range = 1; range < num_threads; ++range)
+            workers.emplace_back(deserialize_range, range);
+        deserialize_range(0);
+    }
+
+    for (auto& [index, error] : errors)
+    {
+        if (!error)
+            continue;
+
+        try
+        {
+            std::rethrow_exception(error);
+        }
+        catch (deserialize_error& ex)
+        {
+            std::string msg = "error when deserializing element " + std::to_string(index);
+            ex.add(msg.c_str());
+            throw;
+        }
+    }
+}
+
 // patch_adl implementation
 
 template <typename T, typename Context>
@@ -804,10 +1466,686 @@ struct backend_traits<json::detail::json_tree_backend>
     {
         patch_adl(json::tree_tag{}, out, value, ctx);
     }
+
+    template <typename T, typename Context>
+    static auto try_deserialize(T& out, const rapidjson::Value& value, Context& ctx,
+                                deserialize_status& status)
+        -> decltype(try_deserialize_adl(json::tree_tag{}, out, value, ctx, status))
+    {
+        return try_deserialize_adl(json::tree_tag{}, out, value, ctx, status);
+    }
 };
 
 } // namespace kl::serialization
 
+// SAX-driven loading (json::load)
+
+namespace kl::json::detail {
+
+enum class sax_event
+{
+    scalar,
+    key,
+    start_object,
+    end_object,
+    start_array,
+    end_array
+};
+
+// Stores the last event reported by rapidjson's iterative parser. Scalars and
+// keys are kept as a non-owning rapidjson::Value so they can be fed straight
+// to the regular deserialize_adl() overloads. Strings point into the parser's
+// stack (or into the input buffer) and are only valid until the next event.
+struct sax_handler : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, sax_handler>
+{
+    bool Null() { return scalar(value.SetNull()); }
+    bool Bool(bool b) { return scalar(value.SetBool(b)); }
+    bool Int(int i) { return scalar(value.SetInt(i)); }
+    bool Uint(unsigned u) { return scalar(value.SetUint(u)); }
+    bool Int64(std::int64_t i64) { return scalar(value.SetInt64(i64)); }
+    bool Uint64(std::uint64_t u64) { return scalar(value.SetUint64(u64)); }
+    bool Double(double d) { return scalar(value.SetDouble(d)); }
+
+    bool String(const char* str, rapidjson::SizeType length, bool)
+    {
+        return scalar(value.SetString(rapidjson::StringRef(str, length)));
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool)
+    {
+        value.SetString(rapidjson::StringRef(str, length));
+        return set(sax_event::key);
+    }
+
+    bool StartObject() { return set(sax_event::start_object); }
+    bool EndObject(rapidjson::SizeType) { return set(sax_event::end_object); }
+    bool StartArray() { return set(sax_event::start_array); }
+    bool EndArray(rapidjson::SizeType) { return set(sax_event::end_array); }
+
+    sax_event event{};
+    rapidjson::Value value;
+
+private:
+    bool scalar(const rapidjson::Value&) { return set(sax_event::scalar); }
+
+    bool set(sax_event e)
+    {
+        event = e;
+        return true;
+    }
+};
+
+// Like rapidjson::InsituStringStream but bounded by the buffer's size instead
+// of a null terminator so it can be used over any mutable memory, e.g. a
+// memory mapped file. Decoded strings are written back into the buffer.
+class insitu_stream
+{
+public:
+    using Ch = char;
+
+    explicit insitu_stream(gsl::span<char> buffer) noexcept
+        : src_{buffer.data()}, dst_{nullptr}, begin_{src_}, end_{src_ + buffer.size()}
+    {
+    }
+
+    Ch Peek() const { return src_ != end_ ? *src_ : '\0'; }
+    Ch Take() { return src_ != end_ ? *src_++ : '\0'; }
+    std::size_t Tell() const { return static_cast<std::size_t>(src_ - begin_); }
+
+    Ch* PutBegin() { return dst_ = src_; }
+    void Put(Ch c)
+    {
+        assert(dst_ < end_);
+        *dst_++ = c;
+    }
+    void Flush() {}
+    std::size_t PutEnd(Ch* begin) { return static_cast<std::size_t>(dst_ - begin); }
+
+private:
+    Ch* src_;
+    Ch* dst_;
+    Ch* begin_;
+    Ch* end_;
+};
+
+// Pull-style cursor over rapidjson's iterative parser. Events are fetched one
+// at a time so apart from the parser's own stack nothing gets allocated.
+template <typename InputStream, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
+class sax_reader
+{
+public:
+    // Strings point into the input buffer and outlive the reader
+    static constexpr bool insitu = (ParseFlags & rapidjson::kParseInsituFlag) != 0;
+
+    explicit sax_reader(InputStream& stream) : stream_{stream}
+    {
+        reader_.IterativeParseInit();
+    }
+
+    sax_event peek()
+    {
+        if (!fetched_)
+        {
+            if (!reader_.template IterativeParseNext<ParseFlags>(stream_, handler_))
+                throw_parse_error();
+            fetched_ = true;
+        }
+        return handler_.event;
+    }
+
+    // Consumes the current event (must be preceded by peek())
+    void next() { fetched_ = false; }
+
+    // Value of the current scalar or key event
+    const rapidjson::Value& value() const { return handler_.value; }
+
+    std::string_view key() const
+    {
+        return {handler_.value.GetString(), handler_.value.GetStringLength()};
+    }
+
+    // Skips the current value along with all of its children
+    void skip()
+    {
+        std::size_t depth = 0;
+        do
+        {
+            switch (peek())
+            {
+            case sax_event::start_object:
+            case sax_event::start_array:
+                ++depth;
+                break;
+            case sax_event::end_object:
+            case sax_event::end_array:
+                --depth;
+                break;
+            default:
+                break;
+            }
+            next();
+        } while (depth != 0);
+    }
+
+    // Makes sure nothing but whitespaces follows the root value
+    void finish()
+    {
+        if (!reader_.IterativeParseComplete())
+        {
+            reader_.template IterativeParseNext<ParseFlags>(stream_, handler_);
+            throw_parse_error();
+        }
+    }
+
+private:
+    [[noreturn]] void throw_parse_error() const
+    {
+        const auto code = reader_.HasParseError()
+                              ? reader_.GetParseErrorCode()
+                              : rapidjson::kParseErrorDocumentRootNotSingular;
+        throw serialization::parse_error{rapidjson::GetParseError_En(code)};
+    }
+
+private:
+    InputStream& stream_;
+    rapidjson::Reader reader_;
+    sax_handler handler_;
+    bool fetched_{false};
+};
+
+template <typename T, typename Context, typename = void>
+struct has_serializer_deserialize : std::false_type {};
+
+template <typename T, typename Context>
+struct has_serializer_deserialize<
+    T, Context,
+    std::void_t<decltype(serialization::serializer<T>::deserialize(
+        std::declval<T&>(), std::declval<const rapidjson::Value&>(),
+        std::declval<Context&>()))>> : std::true_type {};
+
+template <typename T>
+struct is_optional : std::false_type {};
+
+template <typename T>
+struct is_optional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct is_pair : std::false_type {};
+
+template <typename T, typename U>
+struct is_pair<std::pair<T, U>> : std::true_type {};
+
+template <typename T>
+struct is_tuple_alike : is_pair<T> {};
+
+template <typename... Ts>
+struct is_tuple_alike<std::tuple<Ts...>> : std::true_type {};
+
+// Tells if T can be loaded incrementally when the current event opens an
+// object. Otherwise the object is first rebuilt as a rapidjson::Value.
+template <typename T, typename Context>
+constexpr bool is_sax_object_loadable()
+{
+    if constexpr (has_serializer_deserialize<T, Context>::value)
+        return false;
+    else if constexpr (is_optional<T>::value)
+        return is_sax_object_loadable<typename T::value_type, Context>();
+    else if constexpr (ctti::is_reflectable_v<T>)
+        return !ctti::has_any_attribute<T, serialization::attributes::flatten_t>();
+    else
+        return ::kl::detail::is_map_alike<T>::value;
+}
+
+// Same as above but for arrays
+template <typename T, typename Context>
+constexpr bool is_sax_array_loadable()
+{
+    if constexpr (has_serializer_deserialize<T, Context>::value ||
+                  std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                  ctti::is_reflectable_v<T> ||
+                  ::kl::detail::is_map_alike<T>::value)
+        return false;
+    else if constexpr (is_optional<T>::value)
+        return is_sax_array_loadable<typename T::value_type, Context>();
+    else
+        return ::kl::detail::is_range<T>::value || is_tuple_alike<T>::value;
+}
+
+template <typename T, typename Reader, typename Context>
+void load_value(T& out, Reader& reader, Context& ctx);
+
+// Rebuilds the current value (with all its children) as a rapidjson::Value
+template <typename Reader>
+rapidjson::Value load_tree(Reader& reader, json::allocator& alloc)
+{
+    rapidjson::Value ret;
+
+    switch (reader.peek())
+    {
+    case sax_event::scalar:
+    {
+        const auto& value = reader.value();
+        if (value.IsString() && Reader::insitu)
+            ret.SetString(rapidjson::StringRef(value.GetString(), value.GetStringLength()));
+        else if (value.IsString())
+            ret.SetString(value.GetString(), value.GetStringLength(), alloc);
+        else
+            ret = rapidjson::Value{value, alloc};
+        reader.next();
+        break;
+    }
+    case sax_event::start_object:
+        reader.next();
+        ret.SetObject();
+        while (reader.peek() == sax_event::key)
+        {
+            rapidjson::Value name;
+            if constexpr (Reader::insitu)
+                name.SetString(rapidjson::StringRef(reader.value().GetString(),
+                                                    reader.value().GetStringLength()));
+            else
+                name.SetString(reader.value().GetString(), reader.value().GetStringLength(),
+                               alloc);
+            reader.next();
+            rapidjson::Value member = detail::load_tree(reader, alloc);
+            ret.AddMember(std::move(name), std::move(member), alloc);
+        }
+        reader.next();
+        break;
+    case sax_event::start_array:
+        reader.next();
+        ret.SetArray();
+        while (reader.peek() != sax_event::end_array)
+            ret.PushBack(detail::load_tree(reader, alloc), alloc);
+        reader.next();
+        break;
+    default:
+        assert(false);
+        break;
+    }
+
+    return ret;
+}
+
+// Fallback for types that can't be loaded incrementally (user-provided
+// deserialize_adl() or serializer<T>, flattened or sequence-like structs).
+template <typename T, typename Reader, typename Context>
+void load_via_tree(T& out, Reader& reader, Context& ctx)
+{
+    char buffer[1024];
+    json::allocator alloc{buffer, sizeof(buffer)};
+    const rapidjson::Value tree = detail::load_tree(reader, alloc);
+    json::deserialize(out, tree, ctx);
+}
+
+// Loads an element which might not be present in the array (we are already at
+// the end of it) in which case it's deserialized from null, just like json::at() does.
+template <typename T, typename Reader, typename Context>
+void load_element(T& out, Reader& reader, Context& ctx)
+{
+    if (reader.peek() == sax_event::end_array)
+        json::deserialize(out, detail::get_null_value(), ctx);
+    else
+        detail::load_value(out, reader, ctx);
+}
+
+template <typename Reflectable, typename Reader, typename Context>
+bool load_field(Reflectable& out, std::string_view key, Reader& reader, Context& ctx,
+                unsigned char* seen, bool* validate)
+{
+    using namespace serialization::detail;
+
+    const auto* entry = field_name_table<Reflectable>::find(key);
+    if (!entry)
+        return false;
+
+    reader.next();
+
+    // Canonical name takes precedence over aliases and the first
+    // occurrence of a duplicated key wins (same as FindMember())
+    const auto rank = static_cast<unsigned char>(entry->rank + 1);
+    if (seen[entry->index] && seen[entry->index] <= rank)
+    {
+        reader.skip();
+        return true;
+    }
+    seen[entry->index] = rank;
+
+    std::size_t index = 0;
+    ctti::reflect_object(out, [&](auto field) {
+        using Field = decltype(field);
+
+        if constexpr (is_named_deserializable_field<Field>())
+        {
+            if (index++ != entry->index)
+                return;
+
+            try
+            {
+                if (reader.peek() == sax_event::scalar && reader.value().IsNull() &&
+                    apply_null_field_policy(field))
+                {
+                    reader.next();
+                    validate[entry->index] = false;
+                    return;
+                }
+                detail::load_value(field.value(), reader, ctx);
+                validate[entry->index] = true;
+            }
+            catch (serialization::deserialize_error& ex)
+            {
+                std::string msg = "error when deserializing field " + std::string(field.name());
+                ex.add(msg.c_str());
+                throw;
+            }
+        }
+        else
+        {
+            ++index;
+        }
+    });
+
+    return true;
+}
+
+template <typename Reflectable, typename Reader, typename Context>
+void load_extra_field(Reflectable& out, Reader& reader, Context& ctx)
+{
+    ctti::reflect_object(out, [&](auto field) {
+        using Field = decltype(field);
+
+        if constexpr (Field::template has<serialization::attributes::extra_fields_t>())
+        {
+            auto& extras = field.value();
+            std::string key_value{reader.key()};
+            reader.next();
+
+            try
+            {
+                typename remove_cvref_t<decltype(extras)>::mapped_type mapped_value{};
+                detail::load_value(mapped_value, reader, ctx);
+                extras.emplace(std::move(key_value), std::move(mapped_value));
+            }
+            catch (serialization::deserialize_error& ex)
+            {
+                std::string msg = "error when deserializing extra field " + key_value;
+                ex.add(msg.c_str());
+                throw;
+            }
+        }
+    });
+}
+
+template <typename Reflectable, typename Reader, typename Context>
+void load_reflectable(Reflectable& out, Reader& reader, Context& ctx)
+try
+{
+    using namespace serialization::detail;
+
+    static_assert(deserialize_field_names_validator<Reflectable>::validate(),
+                  "reflected deserialization field name collision (duplicate canonical name)");
+
+    constexpr bool has_extra_fields =
+        ctti::has_any_attribute<Reflectable, serialization::attributes::extra_fields_t>();
+    [[maybe_unused]] const auto* reserved_names = reserved_field_names<Reflectable>();
+    if constexpr (has_extra_fields)
+    {
+        ctti::reflect_object(out, [](auto field) {
+            if constexpr (decltype(field)::template has<serialization::attributes::extra_fields_t>())
+                field.value().clear();
+        });
+    }
+
+    // For each field: with which name it was found (0 if not at all) and
+    // whether it still needs to be validated
+    constexpr std::size_t num_fields = ctti::num_fields<Reflectable>();
+    unsigned char seen[num_fields + 1] = {};
+    bool validate[num_fields + 1] = {};
+
+    reader.next();
+    while (reader.peek() == sax_event::key)
+    {
+        const std::string_view key = reader.key();
+        if (detail::load_field(out, key, reader, ctx, seen, validate))
+            continue;
+
+        if constexpr (has_extra_fields)
+        {
+            // Names of skipped fields are reserved too
+            if (reserved_names->find(key) == reserved_names->end())
+            {
+                detail::load_extra_field(out, reader, ctx);
+                continue;
+            }
+        }
+
+        reader.next();
+        reader.skip();
+    }
+    reader.next();
+
+    std::size_t index = 0;
+    ctti::reflect_object(out, [&](auto field) {
+        using Field = decltype(field);
+        const std::size_t field_index = index++;
+
+        check_field_attributes<Field>();
+
+        if constexpr (!Field::template has<serialization::attributes::skip_deserialization_t>() &&
+                      !Field::template has<serialization::attributes::extra_fields_t>())
+        {
+            try
+            {
+                if (!seen[field_index])
+                {
+                    if (apply_missing_field_policy(field))
+                        return;
+                    json::deserialize(field.value(), detail::get_null_value(), ctx);
+                }
+                else if (!validate[field_index])
+                {
+                    return;
+                }
+                validate_field(field);
+            }
+            catch (serialization::deserialize_error& ex)
+            {
+                std::string msg = "error when deserializing field " + std::string(field.name());
+                ex.add(msg.c_str());
+                throw;
+            }
+        }
+    });
+}
+catch (serialization::deserialize_error& ex)
+{
+    std::string msg = "error when deserializing type " + std::string(ctti::name<Reflectable>());
+    ex.add(msg.c_str());
+    throw;
+}
+
+template <typename Map, typename Reader, typename Context>
+void load_map(Map& out, Reader& reader, Context& ctx)
+{
+    out.clear();
+
+    reader.next();
+    while (reader.peek() == sax_event::key)
+    {
+        // Key's string won't outlive the next event so keep a copy for the error message
+        std::string key_name{reader.key()};
+
+        try
+        {
+            typename Map::key_type key_value{};
+            json::deserialize(key_value, reader.value(), ctx);
+            reader.next();
+            typename Map::mapped_type mapped_value{};
+            detail::load_value(mapped_value, reader, ctx);
+            out.emplace(std::move(key_value), std::move(mapped_value));
+        }
+        catch (serialization::deserialize_error& ex)
+        {
+            std::string msg = "error when deserializing field " + key_name;
+            ex.add(msg.c_str());
+            throw;
+        }
+    }
+    reader.next();
+}
+
+template <typename Range, typename Reader, typename Context>
+void load_range(Range& out, Reader& reader, Context& ctx)
+{
+    reader.next();
+
+    if constexpr (::kl::detail::is_growable_range<Range>::value)
+    {
+        out.clear();
+        while (reader.peek() != sax_event::end_array)
+        {
+            try
+            {
+                typename Range::value_type element{};
+                detail::load_value(element, reader, ctx);
+                out.push_back(std::move(element));
+            }
+            catch (serialization::deserialize_error& ex)
+            {
+                std::string msg = "error when deserializing element " + std::to_string(out.size());
+                ex.add(msg.c_str());
+                throw;
+            }
+        }
+    }
+    else
+    {
+        std::size_t index = 0;
+        for (auto& element : out)
+        {
+            try
+            {
+                detail::load_element(element, reader, ctx);
+                ++index;
+            }
+            catch (serialization::deserialize_error& ex)
+            {
+                std::string msg = "error when deserializing element " + std::to_string(index);
+                ex.add(msg.c_str());
+                throw;
+            }
+        }
+
+        if (reader.peek() != sax_event::end_array)
+        {
+            throw serialization::deserialize_error{
+                "sequence size is greater than declared range field count"};
+        }
+    }
+
+    reader.next();
+}
+
+template <typename Enum, typename Reader, typename Context>
+void load_range(enum_set<Enum>& out, Reader& reader, Context& ctx)
+{
+    out = {};
+
+    reader.next();
+    while (reader.peek() != sax_event::end_array)
+    {
+        Enum e{};
+        detail::load_value(e, reader, ctx);
+        out |= e;
+    }
+    reader.next();
+}
+
+template <typename Tuple, typename Reader, typename Context, std::size_t... Is>
+void load_tuple(Tuple& out, Reader& reader, Context& ctx, std::index_sequence<Is...>)
+{
+    reader.next();
+    (detail::load_element(std::get<Is>(out), reader, ctx), ...);
+
+    if (reader.peek() != sax_event::end_array)
+    {
+        throw serialization::deserialize_error{
+            is_pair<Tuple>::value ? "sequence size is greater than pair field count"
+                                  : "sequence size is greater than declared tuple field count"};
+    }
+    reader.next();
+}
+
+template <typename T, typename Reader, typename Context>
+void load_value(T& out, Reader& reader, Context& ctx)
+{
+    static_assert(!std::is_same_v<T, json::view>,
+                  "json::load can't produce views as there's no document to refer to");
+    static_assert(Reader::insitu || !std::is_same_v<T, std::string_view>,
+                  "std::string_view can only refer to the buffer given to json::load_insitu");
+
+    switch (reader.peek())
+    {
+    case sax_event::scalar:
+        // Scalars (and type mismatches) go through the regular tree
+        // deserialization so we get exactly the same semantics and errors
+        json::deserialize(out, reader.value(), ctx);
+        reader.next();
+        return;
+
+    case sax_event::start_object:
+        if constexpr (is_sax_object_loadable<T, Context>())
+        {
+            if constexpr (is_optional<T>::value)
+            {
+                typename T::value_type element{};
+                detail::load_value(element, reader, ctx);
+                out = std::move(element);
+            }
+            else if constexpr (ctti::is_reflectable_v<T>)
+            {
+                detail::load_reflectable(out, reader, ctx);
+            }
+            else
+            {
+                detail::load_map(out, reader, ctx);
+            }
+            return;
+        }
+        break;
+
+    case sax_event::start_array:
+        if constexpr (is_sax_array_loadable<T, Context>())
+        {
+            if constexpr (is_optional<T>::value)
+            {
+                typename T::value_type element{};
+                detail::load_value(element, reader, ctx);
+                out = std::move(element);
+            }
+            else if constexpr (is_tuple_alike<T>::value)
+            {
+                detail::load_tuple(out, reader, ctx,
+                                   std::make_index_sequence<std::tuple_size_v<T>>{});
+            }
+            else
+            {
+                detail::load_range(out, reader, ctx);
+            }
+            return;
+        }
+        break;
+
+    default:
+        assert(false);
+        break;
+    }
+
+    detail::load_via_tree(out, reader, ctx);
+}
+
+} // namespace kl::json::detail
+
 // Top-level functions
 
 namespace kl::json {
@@ -841,6 +2179,17 @@ void dump(const T& obj, Context& ctx)
     serialization::detail::dump_with_backend<stream_tag>(obj, ctx);
 }
 
+// Dumps into the arena's string buffer. The returned text is valid until the
+// next dump or reset of the arena.
+template <typename T>
+std::string_view dump(const T& obj, json::arena& arena)
+{
+    dump_context ctx{arena.writer()};
+
+    json::dump(obj, ctx);
+    return arena.text();
+}
+
 template <typename T>
 rapidjson::Document serialize(const T& obj)
 {
@@ -866,6 +2215,40 @@ inline rapidjson::Document parse(std::string_view text)
     return doc;
 }
 
+// Parses into the arena's document. The returned value is valid until the
+// next parse or reset of the arena.
+inline rapidjson::Value& parse(std::string_view text, json::arena& arena)
+{
+    auto& doc = arena.document();
+    rapidjson::ParseResult ok = doc.Parse(text.data(), text.length());
+    if (!ok)
+        throw kl::serialization::parse_error{rapidjson::GetParseError_En(ok.Code())};
+    return doc;
+}
+
+// Parses the buffer in place: strings are unescaped within the buffer and the
+// returned document refers to them instead of making copies. The buffer must
+// outlive the document and anything deserialized from it as std::string_view.
+inline rapidjson::Document parse_insitu(gsl::span<char> buffer)
+{
+    rapidjson::Document doc;
+    detail::insitu_stream stream{buffer};
+    rapidjson::ParseResult ok = doc.ParseStream<rapidjson::kParseInsituFlag>(stream);
+    if (!ok)
+        throw kl::serialization::parse_error{rapidjson::GetParseError_En(ok.Code())};
+    return doc;
+}
+
+inline rapidjson::Value& parse_insitu(gsl::span<char> buffer, json::arena& arena)
+{
+    auto& doc = arena.document();
+    detail::insitu_stream stream{buffer};
+    rapidjson::ParseResult ok = doc.ParseStream<rapidjson::kParseInsituFlag>(stream);
+    if (!ok)
+        throw kl::serialization::parse_error{rapidjson::GetParseError_En(ok.Code())};
+    return doc;
+}
+
 template <typename T>
 void deserialize(T& out, const rapidjson::Value& value)
 {
@@ -898,6 +2281,37 @@ T deserialize(const rapidjson::Value& value, Context& ctx)
     return out;
 }
 
+// Same as deserialize() but failures are reported through the returned status
+// instead of exceptions (unless T has a user-provided deserializer which
+// throws, see serialization.hpp). Error message, with the path to the
+// offending value, is only formatted when requested. On failure `out` may be
+// left partially filled.
+template <typename T>
+serialization::deserialize_status try_deserialize(T& out, const rapidjson::Value& value)
+{
+    deserialize_context ctx{};
+    return json::try_deserialize(out, value, ctx);
+}
+
+template <typename T, typename Context>
+serialization::deserialize_status try_deserialize(T& out, const rapidjson::Value& value,
+                                                  Context& ctx)
+{
+    serialization::deserialize_status status;
+    json::try_deserialize(out, value, ctx, status);
+    return status;
+}
+
+// Reuses `status` (e.g. across many calls) instead of returning a new one
+template <typename T, typename Context>
+bool try_deserialize(T& out, const rapidjson::Value& value, Context& ctx,
+                     serialization::deserialize_status& status)
+{
+    status.clear();
+    return serialization::detail::try_deserialize_with_backend<tree_tag>(out, value, ctx,
+                                                                         status);
+}
+
 template <typename T, typename Context>
 void patch(T& out, const rapidjson::Value& value, Context& ctx)
 {
@@ -911,6 +2325,82 @@ void patch(T& out, const rapidjson::Value& value)
     json::patch(out, value, ctx);
 }
 
+// Deserializes T straight from the JSON text, driving rapidjson's pull parser
+// without building an intermediate rapidjson::Document. Reflected structs,
+// enums, ranges, maps, tuples and optionals are loaded incrementally and honor
+// the same attributes as json::deserialize(). Any other type (or one with a
+// user-provided serializer<T>) gets its subtree rebuilt as a rapidjson::Value
+// and handed over to json::deserialize(). Since the text is consumed as it
+// goes, a type mismatch can be reported before a syntax error found later on.
+template <typename T, typename Context>
+void load(T& out, std::string_view text, Context& ctx)
+{
+    rapidjson::MemoryStream stream{text.data(), text.size()};
+    detail::sax_reader<rapidjson::MemoryStream> reader{stream};
+    detail::load_value(out, reader, ctx);
+    reader.finish();
+}
+
+template <typename T>
+void load(T& out, std::string_view text)
+{
+    deserialize_context ctx{};
+    json::load(out, text, ctx);
+}
+
+template <typename T>
+T load(std::string_view text)
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    deserialize_context ctx{};
+    return json::load<T>(text, ctx);
+}
+
+template <typename T, typename Context>
+T load(std::string_view text, Context& ctx)
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    T out;
+    json::load(out, text, ctx);
+    return out;
+}
+
+// json::load() over a mutable buffer which is parsed in place (see
+// parse_insitu()). Apart from what json::load() supports, T may also hold
+// std::string_view fields which then point straight into the buffer.
+template <typename T, typename Context>
+void load_insitu(T& out, gsl::span<char> buffer, Context& ctx)
+{
+    detail::insitu_stream stream{buffer};
+    detail::sax_reader<detail::insitu_stream, rapidjson::kParseInsituFlag> reader{stream};
+    detail::load_value(out, reader, ctx);
+    reader.finish();
+}
+
+template <typename T>
+void load_insitu(T& out, gsl::span<char> buffer)
+{
+    deserialize_context ctx{};
+    json::load_insitu(out, buffer, ctx);
+}
+
+template <typename T>
+T load_insitu(gsl::span<char> buffer)
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    deserialize_context ctx{};
+    return json::load_insitu<T>(buffer, ctx);
+}
+
+template <typename T, typename Context>
+T load_insitu(gsl::span<char> buffer, Context& ctx)
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    T out;
+    json::load_insitu(out, buffer, ctx);
+    return out;
+}
+
 } // namespace kl::json
 
 inline rapidjson::Document operator""_json(const char* s, std::size_t len)
@@ -2,7 +2,15 @@
 
 #include <rapidjson/fwd.h>
 
+#include <gsl/span>
+
 #include <string>
+#include <string_view>
+
+namespace kl::serialization {
+
+class deserialize_status;
+} // namespace kl::serialization
 
 namespace kl::json {
 
@@ -19,9 +27,12 @@ void dump(const T& obj, Context& ctx);
 
 using allocator = rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>;
 
+class arena;
+class string_writer;
 class owning_serialize_context;
 class serialize_context;
 class deserialize_context;
+class parallel_deserialize_context;
 
 template <typename T>
 rapidjson::Document serialize(const T& obj);
@@ -41,12 +52,47 @@ T deserialize(const rapidjson::Value& value);
 template <typename T, typename Context>
 T deserialize(const rapidjson::Value& value, Context& ctx);
 
+template <typename T>
+serialization::deserialize_status try_deserialize(T& out, const rapidjson::Value& value);
+
+template <typename T, typename Context>
+serialization::deserialize_status try_deserialize(T& out, const rapidjson::Value& value,
+                                                  Context& ctx);
+
+template <typename T, typename Context>
+bool try_deserialize(T& out, const rapidjson::Value& value, Context& ctx,
+                     serialization::deserialize_status& status);
+
 template <typename T>
 void patch(T& out, const rapidjson::Value& value);
 
 template <typename T, typename Context>
 void patch(T& out, const rapidjson::Value& value, Context& ctx);
 
+template <typename T>
+void load(T& out, std::string_view text);
+
+template <typename T, typename Context>
+void load(T& out, std::string_view text, Context& ctx);
+
+template <typename T>
+T load(std::string_view text);
+
+template <typename T, typename Context>
+T load(std::string_view text, Context& ctx);
+
+template <typename T>
+void load_insitu(T& out, gsl::span<char> buffer);
+
+template <typename T, typename Context>
+void load_insitu(T& out, gsl::span<char> buffer, Context& ctx);
+
+template <typename T>
+T load_insitu(gsl::span<char> buffer);
+
+template <typename T, typename Context>
+T load_insitu(gsl::span<char> buffer, Context& ctx);
+
 struct deserialize_error;
 struct parse_error;
 } // namespace kl::json
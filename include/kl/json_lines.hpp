@@ -0,0 +1,356 @@
+#pragma once
+
+#include "kl/file_view.hpp"
+#include "kl/json.hpp"
+#include "kl/serialization_error.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kl::json {
+
+enum class lines_order
+{
+    // Records are handed over to the callback one at a time, on the calling
+    // thread and in the order they appear in the input
+    preserved,
+    // Records are handed over as soon as they are deserialized. The callback
+    // is invoked concurrently from the worker threads.
+    unordered
+};
+
+struct lines_options
+{
+    // Number of worker threads, 0 means std::thread::hardware_concurrency()
+    unsigned num_threads = 0;
+    // Input is split into chunks of about that many bytes (rounded up to the
+    // end of a line) which are then parsed by the workers
+    std::size_t chunk_size = 1024 * 1024;
+    lines_order order = lines_order::preserved;
+};
+
+namespace detail {
+
+// Splits the text into chunks made of whole lines
+inline std::vector<std::string_view> split_lines_chunks(std::string_view text,
+                                                        std::size_t chunk_size)
+{
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+    std::vector<std::string_view> chunks;
+    chunks.reserve(text.size() / chunk_size + 1);
+    while (!text.empty())
+    {
+        if (text.size() <= chunk_size)
+        {
+            chunks.push_back(text);
+            break;
+        }
+
+        const auto eol = text.find('\n', chunk_size - 1);
+        const auto len = eol == std::string_view::npos ? text.size() : eol + 1;
+        chunks.push_back(text.substr(0, len));
+        text.remove_prefix(len);
+    }
+    return chunks;
+}
+
+inline bool is_blank_line(std::string_view line)
+{
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+template <typename Fn>
+void for_each_line(std::string_view chunk, Fn&& fn)
+{
+    while (!chunk.empty())
+    {
+        const auto eol = chunk.find('\n');
+        const auto line = chunk.substr(0, eol);
+        if (!is_blank_line(line))
+            fn(line);
+        if (eol == std::string_view::npos)
+            break;
+        chunk.remove_prefix(eol + 1);
+    }
+}
+
+template <typename T, typename Callback>
+class lines_reader
+{
+public:
+    lines_reader(std::string_view text, Callback& callback, const lines_options& opts)
+        : text_{text},
+          chunks_{split_lines_chunks(text, opts.chunk_size)},
+          callback_{callback},
+          num_threads_{opts.num_threads ? opts.num_threads
+                                        : std::max(std::thread::hardware_concurrency(), 1u)},
+          max_in_flight_{2 * static_cast<std::size_t>(num_threads_)},
+          ordered_{opts.order == lines_order::preserved}
+    {
+        if (ordered_)
+            results_.resize(chunks_.size());
+    }
+
+    void run()
+    {
+        if (chunks_.empty())
+            return;
+
+        num_threads_ = static_cast<unsigned>(
+            std::min<std::size_t>(num_threads_, chunks_.size()));
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads_);
+        try
+        {
+            for (unsigned i = 0; i < num_threads_; ++i)
+                workers.emplace_back([this] { work(); });
+            if (ordered_)
+                deliver();
+        }
+        catch (...)
+        {
+            // Thrown by the callback (when ordered) or when starting a worker
+            stop(std::current_exception());
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (callback_error_)
+            std::rethrow_exception(callback_error_);
+        if (error_)
+            rethrow();
+    }
+
+private:
+    struct chunk_result
+    {
+        std::vector<T> records;
+        bool ready = false;
+    };
+
+    void work()
+    {
+        json::deserialize_context ctx{};
+
+        for (;;)
+        {
+            const auto index = next_chunk_.fetch_add(1);
+            if (index >= chunks_.size() || index > error_chunk_.load())
+                return;
+
+            if (ordered_)
+            {
+                std::unique_lock lock{mutex_};
+                chunk_freed_.wait(lock, [&] {
+                    return index < delivered_ + max_in_flight_ || index > error_chunk_.load();
+                });
+                if (index > error_chunk_.load())
+                    return;
+            }
+
+            std::vector<T> records;
+            const auto chunk = chunks_[index];
+            std::string_view current;
+            bool in_callback = false;
+            try
+            {
+                detail::for_each_line(chunk, [&](std::string_view line) {
+                    if (stopped_.load(std::memory_order_relaxed))
+                        return;
+
+                    current = line;
+                    T record{};
+                    json::load(record, line, ctx);
+                    if (ordered_)
+                    {
+                        records.push_back(std::move(record));
+                    }
+                    else
+                    {
+                        in_callback = true;
+                        callback_(std::move(record));
+                        in_callback = false;
+                    }
+                });
+            }
+            catch (...)
+            {
+                if (in_callback)
+                {
+                    stop(std::current_exception());
+                    return;
+                }
+
+                // Records preceding the failed one are still delivered. Fail
+                // first so nothing past this chunk gets delivered.
+                fail(index, static_cast<std::size_t>(current.data() - text_.data()),
+                     std::current_exception());
+                publish(index, std::move(records));
+                return;
+            }
+
+            publish(index, std::move(records));
+        }
+    }
+
+    void publish(std::size_t index, std::vector<T> records)
+    {
+        if (!ordered_)
+            return;
+
+        {
+            std::lock_guard lock{mutex_};
+            results_[index].records = std::move(records);
+            results_[index].ready = true;
+        }
+        chunk_ready_.notify_all();
+    }
+
+    // Invokes the callback on the calling thread in the input order
+    void deliver()
+    {
+        for (std::size_t index = 0; index < chunks_.size(); ++index)
+        {
+            std::vector<T> records;
+            {
+                std::unique_lock lock{mutex_};
+                chunk_ready_.wait(lock, [&] {
+                    return results_[index].ready || error_chunk_.load() < index;
+                });
+                if (error_chunk_.load() < index)
+                    return;
+                records = std::move(results_[index].records);
+            }
+
+            for (auto& record : records)
+                callback_(std::move(record));
+
+            {
+                std::lock_guard lock{mutex_};
+                ++delivered_;
+            }
+            chunk_freed_.notify_all();
+        }
+    }
+
+    void fail(std::size_t chunk, std::size_t offset, std::exception_ptr error)
+    {
+        {
+            std::lock_guard lock{mutex_};
+            // Report the first failed record. Chunks before it are still
+            // processed (and delivered, if ordered) in full, later ones are
+            // abandoned.
+            if (!error_ || offset < error_offset_)
+            {
+                error_ = std::move(error);
+                error_offset_ = offset;
+            }
+            if (chunk < error_chunk_.load())
+                error_chunk_ = chunk;
+        }
+        chunk_ready_.notify_all();
+        chunk_freed_.notify_all();
+    }
+
+    // Errors not tied to any line are rethrown as they are, ahead of any
+    // deserialization error. Stops all the workers.
+    void stop(std::exception_ptr error)
+    {
+        {
+            std::lock_guard lock{mutex_};
+            if (!callback_error_)
+                callback_error_ = std::move(error);
+            stopped_ = true;
+            error_chunk_ = 0;
+        }
+        chunk_ready_.notify_all();
+        chunk_freed_.notify_all();
+    }
+
+    [[noreturn]] void rethrow() const
+    {
+        const auto line =
+            std::count(text_.begin(), text_.begin() + error_offset_, '\n') + 1;
+        const auto msg = "error when deserializing line " + std::to_string(line);
+
+        try
+        {
+            std::rethrow_exception(error_);
+        }
+        catch (serialization::deserialize_error& ex)
+        {
+            ex.add(msg.c_str());
+            throw;
+        }
+        catch (serialization::parse_error& ex)
+        {
+            throw serialization::parse_error{std::string{ex.what()} + "\n" + msg};
+        }
+    }
+
+private:
+    static constexpr std::size_t no_offset = std::numeric_limits<std::size_t>::max();
+
+    std::string_view text_;
+    std::vector<std::string_view> chunks_;
+    Callback& callback_;
+    unsigned num_threads_;
+    std::size_t max_in_flight_;
+    bool ordered_;
+
+    std::atomic<std::size_t> next_chunk_{0};
+    // Index of the first chunk which failed, no chunks past it are processed
+    std::atomic<std::size_t> error_chunk_{std::numeric_limits<std::size_t>::max()};
+
+    std::mutex mutex_;
+    std::condition_variable chunk_ready_;
+    std::condition_variable chunk_freed_;
+    std::vector<chunk_result> results_;
+    std::size_t delivered_{0};
+    std::exception_ptr error_;
+    std::size_t error_offset_{no_offset};
+    // Thrown by the callback or when starting the workers
+    std::exception_ptr callback_error_;
+    std::atomic<bool> stopped_{false};
+};
+} // namespace detail
+
+// Reads newline-delimited JSON (JSON Lines), deserializing each non-blank
+// line into T with json::load() and passing it to `callback(T&&)`. Lines are
+// processed in chunks on a pool of worker threads. Errors are reported for
+// the first offending line (with the line number appended to the message)
+// after all the records preceding it were delivered. Exceptions thrown by the
+// callback stop the processing and are propagated unchanged.
+template <typename T, typename Callback>
+void for_each_line(std::string_view text, Callback&& callback, const lines_options& opts = {})
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    detail::lines_reader<T, std::remove_reference_t<Callback>> reader{text, callback, opts};
+    reader.run();
+}
+
+template <typename T, typename Callback>
+void for_each_line(const kl::file_view& file, Callback&& callback,
+                   const lines_options& opts = {})
+{
+    const auto bytes = file.get_bytes();
+    json::for_each_line<T>(
+        std::string_view{reinterpret_cast<const char*>(bytes.data()), bytes.size()},
+        std::forward<Callback>(callback), opts);
+}
+
+} // namespace kl::json
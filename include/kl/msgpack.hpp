@@ -0,0 +1,771 @@
+#pragma once
+
+#include "kl/msgpack_fwd.hpp"
+#include "kl/enum_reflector.hpp"
+#include "kl/reflect_enum.hpp"
+#include "kl/serialization.hpp"
+#include "kl/serialization_error.hpp"
+#include "kl/serialization_fwd.hpp"
+#include "kl/utility.hpp"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Self-describing binary backend using MessagePack encoding
+ * (https://github.com/msgpack/msgpack/blob/master/spec.md).
+ *
+ * Dumping goes straight to a byte buffer (msgpack::writer). Reading is done
+ * in-place: msgpack::parse() validates the buffer once and returns a
+ * msgpack::value pointing into it, which is then walked by deserialize() and
+ * patch() without building any intermediate tree. Reflectable structs are
+ * encoded as maps keyed by field names so they round-trip the same way as with
+ * the json and yaml backends.
+ */
+
+namespace kl::msgpack {
+
+namespace detail {
+
+struct msgpack_stream_backend;
+struct msgpack_tree_backend;
+
+} // namespace detail
+
+struct stream_tag : serialization::backend_tag<detail::msgpack_stream_backend> {};
+struct tree_tag   : serialization::backend_tag<detail::msgpack_tree_backend>   {};
+
+enum class type
+{
+    nil,
+    boolean,
+    integer,
+    floating,
+    string,
+    binary,
+    array,
+    map,
+    extension
+};
+KL_REFLECT_ENUM(type, nil, boolean, integer, floating, string, binary, array, map, extension)
+
+namespace detail {
+
+inline constexpr std::byte nil_value[] = {std::byte{0xc0}};
+
+// Returns the first byte past the encoded value starting at `data`. Value must
+// come from a buffer accepted by msgpack::parse().
+const std::byte* skip(const std::byte* data) noexcept;
+
+// Returns the first byte of the first child of an array or map value
+const std::byte* first_child(const std::byte* data) noexcept;
+} // namespace detail
+
+// Non-owning reference to a validated MessagePack value. The underlying buffer
+// must outlive it. Default constructed value is nil.
+class value
+{
+public:
+    value() noexcept = default;
+
+    msgpack::type type() const noexcept;
+
+    bool is_nil() const noexcept { return *data_ == detail::nil_value[0]; }
+    bool is_map() const noexcept { return type() == msgpack::type::map; }
+    bool is_array() const noexcept { return type() == msgpack::type::array; }
+    bool is_string() const noexcept { return type() == msgpack::type::string; }
+
+    // Integer which can be represented as int64_t or uint64_t respectively
+    bool is_int64() const noexcept;
+    bool is_uint64() const noexcept;
+
+    bool get_bool() const noexcept { return *data_ == std::byte{0xc3}; }
+    std::int64_t get_int64() const noexcept;
+    std::uint64_t get_uint64() const noexcept;
+    // Works for integers too
+    double get_double() const noexcept;
+    std::string_view get_string() const noexcept;
+    gsl::span<const std::byte> get_binary() const noexcept;
+
+    // Number of elements (array), members (map) or bytes (string, binary)
+    std::size_t size() const noexcept;
+
+    // Return nil if index is out-of-bounds or there's no such member
+    msgpack::value at(std::size_t index) const noexcept;
+    msgpack::value at(std::string_view key) const noexcept;
+    bool has_field(std::string_view key) const noexcept;
+
+    template <typename Visitor>
+    void for_each_element(Visitor&& visitor) const
+    {
+        const auto* child = detail::first_child(data_);
+        for (std::size_t i = 0, n = size(); i < n; ++i)
+        {
+            const msgpack::value element{child};
+            child = detail::skip(child);
+            visitor(element);
+        }
+    }
+
+    template <typename Visitor>
+    void for_each_field(Visitor&& visitor) const
+    {
+        const auto* child = detail::first_child(data_);
+        for (std::size_t i = 0, n = size(); i < n; ++i)
+        {
+            const msgpack::value key{child};
+            child = detail::skip(child);
+            const msgpack::value field{child};
+            child = detail::skip(child);
+            visitor(key, field);
+        }
+    }
+
+    // Hands out array elements front to back. Unlike at(), which skips over
+    // all preceding elements on every call, each next() only skips the last one.
+    class cursor
+    {
+    public:
+        explicit cursor(const msgpack::value& array) noexcept
+            : next_{array.is_array() ? detail::first_child(array.data_) : detail::nil_value},
+              remaining_{array.is_array() ? array.size() : 0}
+        {
+        }
+
+        // Returns nil past the end
+        msgpack::value next() noexcept
+        {
+            if (!remaining_)
+                return {};
+
+            const msgpack::value element{next_};
+            if (--remaining_)
+                next_ = detail::skip(next_);
+            return element;
+        }
+
+    private:
+        const std::byte* next_;
+        std::size_t remaining_;
+    };
+
+    // Encoded bytes of the value (including all its children)
+    gsl::span<const std::byte> encoded() const noexcept
+    {
+        return {data_, static_cast<std::size_t>(detail::skip(data_) - data_)};
+    }
+
+private:
+    explicit value(const std::byte* data) noexcept : data_{data} {}
+
+    friend msgpack::value parse(gsl::span<const std::byte> data);
+
+private:
+    const std::byte* data_{detail::nil_value};
+};
+
+// Checks that `data` holds exactly one well-formed MessagePack value and
+// returns it. Throws serialization::parse_error otherwise.
+msgpack::value parse(gsl::span<const std::byte> data);
+
+// Encodes MessagePack values into a growable buffer. Integers use the smallest
+// encoding holding given value. Arrays and maps don't need to know their size
+// up-front: the header is written once the container is closed, so buffer()
+// holds the final encoding only while no container is open. Strings, binaries
+// and containers too big for the format throw std::length_error.
+class writer
+{
+public:
+    void nil();
+    void boolean(bool b);
+    void int64(std::int64_t i);
+    void uint64(std::uint64_t u);
+    void float32(float f);
+    void float64(double d);
+    void string(std::string_view str);
+    void binary(gsl::span<const std::byte> bin);
+    // Copies already encoded value
+    void encoded(const msgpack::value& v);
+
+    void begin_array();
+    void end_array();
+    void begin_map();
+    void end_map();
+
+    const std::vector<std::byte>& buffer() const noexcept { return buffer_; }
+    std::vector<std::byte> release() noexcept;
+    void clear() noexcept;
+
+private:
+    void add_value();
+    void begin_container();
+    void end_container(std::uint8_t fix_marker, std::uint8_t marker16, std::uint8_t marker32,
+                       bool is_map);
+    void compact_headers() noexcept;
+
+private:
+    struct container
+    {
+        std::size_t header; // index into headers_
+        std::size_t count;
+    };
+
+    struct header
+    {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::vector<std::byte> buffer_;
+    std::vector<container> open_;
+    // Placeholders of the containers in the outermost open one, in buffer order
+    std::vector<header> headers_;
+};
+
+class dump_context : public stream_tag
+{
+public:
+    explicit dump_context(msgpack::writer& writer, bool skip_null_fields = true)
+        : writer_{writer}, skip_null_fields_{skip_null_fields}
+    {
+    }
+
+    msgpack::writer& writer() const { return writer_; }
+
+    template <typename Value>
+    bool skip_null_value(const Value& value)
+    {
+        return skip_null_fields_ && serialization::is_null_value(value);
+    }
+
+private:
+    msgpack::writer& writer_;
+    bool skip_null_fields_;
+};
+
+class deserialize_context : public tree_tag
+{
+};
+
+namespace detail {
+
+std::string type_name(const msgpack::value& value);
+
+void expect_integer(const msgpack::value& value);
+void expect_number(const msgpack::value& value);
+void expect_boolean(const msgpack::value& value);
+void expect_string(const msgpack::value& value);
+void expect_map(const msgpack::value& value);
+void expect_array(const msgpack::value& value);
+[[noreturn]] void throw_lossy_conversion();
+
+// Non-throwing counterparts of the above, used by try_deserialize()
+bool check_integer(const msgpack::value& value, serialization::deserialize_status& status);
+bool check_number(const msgpack::value& value, serialization::deserialize_status& status);
+bool check_boolean(const msgpack::value& value, serialization::deserialize_status& status);
+bool check_string(const msgpack::value& value, serialization::deserialize_status& status);
+bool check_map(const msgpack::value& value, serialization::deserialize_status& status);
+bool check_array(const msgpack::value& value, serialization::deserialize_status& status);
+bool fail_lossy_conversion(serialization::deserialize_status& status);
+
+template <typename Integral>
+bool get_integral(const msgpack::value& value, Integral& out) noexcept
+{
+    if constexpr (std::is_signed_v<Integral>)
+    {
+        if (!value.is_int64())
+            return false;
+        const auto i = value.get_int64();
+        if (i < (std::numeric_limits<Integral>::min)() ||
+            i > (std::numeric_limits<Integral>::max)())
+            return false;
+        out = static_cast<Integral>(i);
+    }
+    else
+    {
+        if (!value.is_uint64())
+            return false;
+        const auto u = value.get_uint64();
+        if (u > (std::numeric_limits<Integral>::max)())
+            return false;
+        out = static_cast<Integral>(u);
+    }
+    return true;
+}
+
+struct msgpack_stream_backend
+{
+    template <typename T, typename Context>
+    static void dump(const T& value, Context& ctx)
+    {
+        msgpack::dump(value, ctx);
+    }
+
+    // Map stuff
+
+    template <typename Context>
+    static void begin_map(Context& ctx)
+    {
+        ctx.writer().begin_map();
+    }
+
+    template <typename Context>
+    static void end_map(Context& ctx)
+    {
+        ctx.writer().end_map();
+    }
+
+    template <typename Key, typename Context>
+    static void write_key(const Key& key, Context& ctx)
+    {
+        msgpack::dump(key, ctx);
+    }
+
+    // Sequence stuff
+
+    template <typename Context>
+    static void begin_sequence(Context& ctx)
+    {
+        ctx.writer().begin_array();
+    }
+
+    template <typename Context>
+    static void end_sequence(Context& ctx)
+    {
+        ctx.writer().end_array();
+    }
+};
+
+struct msgpack_tree_backend
+{
+    using value_type = msgpack::value;
+
+    // These are backend_traits hooks. Go straight to the dispatcher instead of
+    // bouncing through the public msgpack::* wrappers.
+    template <typename T, typename Context>
+    static void deserialize(T& out, const value_type& value, Context& ctx)
+    {
+        serialization::detail::deserialize_with_backend<msgpack::tree_tag>(out, value, ctx);
+    }
+
+    template <typename T, typename Context>
+    static void patch(T& out, const value_type& value, Context& ctx)
+    {
+        serialization::detail::patch_with_backend<msgpack::tree_tag>(out, value, ctx);
+    }
+
+    template <typename T, typename Context>
+    static bool try_deserialize(T& out, const value_type& value, Context& ctx,
+                                serialization::deserialize_status& status)
+    {
+        return serialization::detail::try_deserialize_with_backend<msgpack::tree_tag>(
+            out, value, ctx, status);
+    }
+
+    // Map stuff
+
+    static void expect_map(const value_type& value) { detail::expect_map(value); }
+    static bool try_expect_map(const value_type& value, serialization::deserialize_status& status)
+    {
+        return detail::check_map(value, status);
+    }
+    static bool is_map(const value_type& value) { return value.is_map(); }
+
+    template <typename Visitor>
+    static void for_each_field(const value_type& value, Visitor&& visitor)
+    {
+        value.for_each_field(visitor);
+    }
+
+    // Non-string keys never match a reflected field
+    static std::string_view field_key(const value_type& key)
+    {
+        return key.is_string() ? key.get_string() : std::string_view{};
+    }
+
+    // Sequence stuff
+
+    static void expect_sequence(const value_type& value) { detail::expect_array(value); }
+    static bool try_expect_sequence(const value_type& value,
+                                    serialization::deserialize_status& status)
+    {
+        return detail::check_array(value, status);
+    }
+    static bool is_sequence(const value_type& value) { return value.is_array(); }
+
+    template <typename Visitor>
+    static void for_each_element(const value_type& value, Visitor&& visitor)
+    {
+        value.for_each_element(visitor);
+    }
+
+    // Rest of the stuff
+
+    static bool is_null(const value_type& value) { return value.is_nil(); }
+    static std::size_t size(const value_type& value) { return value.size(); }
+
+    static bool has_field(const value_type& object, const char* name)
+    {
+        return object.has_field(name);
+    }
+
+    static value_type at_field(const value_type& value, const char* name)
+    {
+        return value.at(std::string_view{name});
+    }
+
+    static value_type at_index(const value_type& value, std::size_t index)
+    {
+        return value.at(index);
+    }
+
+    // at_index() is linear so deserializers walking a whole sequence use this
+    using sequence_cursor = msgpack::value::cursor;
+
+    static std::string type_name(const value_type& value) { return detail::type_name(value); }
+};
+
+} // namespace detail
+} // namespace kl::msgpack
+
+namespace kl::serialization {
+
+// dump_adl implementation for more complex types (like seqs, maps, reflectable structs and enums)
+template <typename T, typename Context>
+auto dump_adl(msgpack::stream_tag, const T& value, Context& ctx)
+    -> decltype(detail::dump_adl<msgpack::detail::msgpack_stream_backend>(value, ctx), void())
+{
+    detail::dump_adl<msgpack::detail::msgpack_stream_backend>(value, ctx);
+}
+
+// dump_adl implementations for simple types
+
+template <typename Integral, typename Context, enable_if<std::is_integral<Integral>> = true>
+void dump_adl(msgpack::stream_tag, Integral value, Context& ctx)
+{
+    if constexpr (std::is_signed_v<Integral>)
+        ctx.writer().int64(value);
+    else
+        ctx.writer().uint64(value);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, bool value, Context& ctx)
+{
+    ctx.writer().boolean(value);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, float value, Context& ctx)
+{
+    ctx.writer().float32(value);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, double value, Context& ctx)
+{
+    ctx.writer().float64(value);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, std::nullptr_t, Context& ctx)
+{
+    ctx.writer().nil();
+}
+
+// std::string and std::string_view would be otherwise caught by dump_adl for "range alike"
+template <typename Context>
+void dump_adl(msgpack::stream_tag, const std::string& str, Context& ctx)
+{
+    ctx.writer().string(str);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, std::string_view str, Context& ctx)
+{
+    ctx.writer().string(str);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, const char* str, Context& ctx)
+{
+    ctx.writer().string(str);
+}
+
+template <typename Context>
+void dump_adl(msgpack::stream_tag, const msgpack::value& value, Context& ctx)
+{
+    ctx.writer().encoded(value);
+}
+
+// deserialize_adl implementation for more complex types (like seqs, maps, reflectable structs and enums)
+template <typename T, typename Context>
+auto deserialize_adl(msgpack::tree_tag, T& out, const msgpack::value& value, Context& ctx)
+    -> decltype(detail::deserialize_adl<msgpack::detail::msgpack_tree_backend>(out, value, ctx),
+                void())
+{
+    detail::deserialize_adl<msgpack::detail::msgpack_tree_backend>(out, value, ctx);
+}
+
+// deserialize_adl implementations for simple types
+
+template <typename Integral, typename Context, enable_if<std::is_integral<Integral>> = true>
+void deserialize_adl(msgpack::tree_tag, Integral& out, const msgpack::value& value, Context&)
+{
+    msgpack::detail::expect_integer(value);
+    if (!msgpack::detail::get_integral(value, out))
+        msgpack::detail::throw_lossy_conversion();
+}
+
+template <typename Context>
+void deserialize_adl(msgpack::tree_tag, bool& out, const msgpack::value& value, Context&)
+{
+    msgpack::detail::expect_boolean(value);
+    out = value.get_bool();
+}
+
+template <typename Floating, typename Context,
+          enable_if<std::is_floating_point<Floating>> = true>
+void deserialize_adl(msgpack::tree_tag, Floating& out, const msgpack::value& value, Context&)
+{
+    msgpack::detail::expect_number(value);
+    out = static_cast<Floating>(value.get_double());
+}
+
+template <typename Context>
+void deserialize_adl(msgpack::tree_tag, std::string& out, const msgpack::value& value,
+                     Context&)
+{
+    msgpack::detail::expect_string(value);
+    out = value.get_string();
+}
+
+template <typename Context>
+void deserialize_adl(msgpack::tree_tag, std::string_view& out, const msgpack::value& value,
+                     Context&)
+{
+    // Points into the buffer given to msgpack::parse() so it must outlive `out`
+    msgpack::detail::expect_string(value);
+    out = value.get_string();
+}
+
+template <typename Context>
+void deserialize_adl(msgpack::tree_tag, msgpack::value& out, const msgpack::value& value,
+                     Context&)
+{
+    out = value;
+}
+
+// try_deserialize_adl implementations for simple types
+
+template <typename Integral, typename Context, enable_if<std::is_integral<Integral>> = true>
+bool try_deserialize_adl(msgpack::tree_tag, Integral& out, const msgpack::value& value,
+                         Context&, deserialize_status& status)
+{
+    if (!msgpack::detail::check_integer(value, status))
+        return false;
+    return msgpack::detail::get_integral(value, out) ||
+           msgpack::detail::fail_lossy_conversion(status);
+}
+
+template <typename Context>
+bool try_deserialize_adl(msgpack::tree_tag, bool& out, const msgpack::value& value, Context&,
+                         deserialize_status& status)
+{
+    if (!msgpack::detail::check_boolean(value, status))
+        return false;
+    out = value.get_bool();
+    return true;
+}
+
+template <typename Floating, typename Context,
+          enable_if<std::is_floating_point<Floating>> = true>
+bool try_deserialize_adl(msgpack::tree_tag, Floating& out, const msgpack::value& value,
+                         Context&, deserialize_status& status)
+{
+    if (!msgpack::detail::check_number(value, status))
+        return false;
+    out = static_cast<Floating>(value.get_double());
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(msgpack::tree_tag, std::string& out, const msgpack::value& value,
+                         Context&, deserialize_status& status)
+{
+    if (!msgpack::detail::check_string(value, status))
+        return false;
+    out = value.get_string();
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(msgpack::tree_tag, std::string_view& out, const msgpack::value& value,
+                         Context&, deserialize_status& status)
+{
+    if (!msgpack::detail::check_string(value, status))
+        return false;
+    out = value.get_string();
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(msgpack::tree_tag, msgpack::value& out, const msgpack::value& value,
+                         Context&, deserialize_status&)
+{
+    out = value;
+    return true;
+}
+
+// patch_adl implementation
+
+template <typename T, typename Context>
+auto patch_adl(msgpack::tree_tag, T& out, const msgpack::value& value, Context& ctx)
+    -> decltype(detail::patch_adl<msgpack::detail::msgpack_tree_backend>(out, value, ctx),
+                void())
+{
+    detail::patch_adl<msgpack::detail::msgpack_tree_backend>(out, value, ctx);
+}
+
+template <>
+struct backend_traits<msgpack::detail::msgpack_stream_backend>
+{
+    template <typename T, typename Context>
+    static auto dump(const T& obj, Context& ctx)
+        -> decltype(dump_adl(msgpack::stream_tag{}, obj, ctx), void())
+    {
+        dump_adl(msgpack::stream_tag{}, obj, ctx);
+    }
+};
+
+template <>
+struct backend_traits<msgpack::detail::msgpack_tree_backend>
+{
+    template <typename T, typename Context>
+    static auto deserialize(T& out, const msgpack::value& value, Context& ctx)
+        -> decltype(deserialize_adl(msgpack::tree_tag{}, out, value, ctx), void())
+    {
+        deserialize_adl(msgpack::tree_tag{}, out, value, ctx);
+    }
+
+    template <typename T, typename Context>
+    static auto patch(T& out, const msgpack::value& value, Context& ctx)
+        -> decltype(patch_adl(msgpack::tree_tag{}, out, value, ctx), void())
+    {
+        patch_adl(msgpack::tree_tag{}, out, value, ctx);
+    }
+
+    template <typename T, typename Context>
+    static auto try_deserialize(T& out, const msgpack::value& value, Context& ctx,
+                                deserialize_status& status)
+        -> decltype(try_deserialize_adl(msgpack::tree_tag{}, out, value, ctx, status))
+    {
+        return try_deserialize_adl(msgpack::tree_tag{}, out, value, ctx, status);
+    }
+};
+
+} // namespace kl::serialization
+
+// Top level functions
+
+namespace kl::msgpack {
+
+template <typename T>
+std::vector<std::byte> dump(const T& obj)
+{
+    msgpack::writer writer;
+    dump_context ctx{writer};
+
+    msgpack::dump(obj, ctx);
+    return writer.release();
+}
+
+template <typename T, typename Context>
+void dump(const T& obj, Context& ctx)
+{
+    serialization::detail::dump_with_backend<stream_tag>(obj, ctx);
+}
+
+template <typename T>
+void deserialize(T& out, const msgpack::value& value)
+{
+    deserialize_context ctx{};
+    msgpack::deserialize(out, value, ctx);
+}
+
+template <typename T, typename Context>
+void deserialize(T& out, const msgpack::value& value, Context& ctx)
+{
+    serialization::detail::deserialize_with_backend<tree_tag>(out, value, ctx);
+}
+
+// Shorter version of deserialize which can't be overloaded. Only use to invoke
+// the deserialize() without providing a bit weird first parameter.
+template <typename T>
+T deserialize(const msgpack::value& value)
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    deserialize_context ctx{};
+    return msgpack::deserialize<T>(value, ctx);
+}
+
+template <typename T, typename Context>
+T deserialize(const msgpack::value& value, Context& ctx)
+{
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    T out;
+    msgpack::deserialize(out, value, ctx);
+    return out;
+}
+
+// Same as deserialize() but failures are reported through the returned status
+// instead of exceptions (see json::try_deserialize()). On failure `out` may be
+// left partially filled.
+template <typename T>
+serialization::deserialize_status try_deserialize(T& out, const msgpack::value& value)
+{
+    deserialize_context ctx{};
+    return msgpack::try_deserialize(out, value, ctx);
+}
+
+template <typename T, typename Context>
+serialization::deserialize_status try_deserialize(T& out, const msgpack::value& value,
+                                                  Context& ctx)
+{
+    serialization::deserialize_status status;
+    msgpack::try_deserialize(out, value, ctx, status);
+    return status;
+}
+
+// Reuses `status` (e.g. across many calls) instead of returning a new one
+template <typename T, typename Context>
+bool try_deserialize(T& out, const msgpack::value& value, Context& ctx,
+                     serialization::deserialize_status& status)
+{
+    status.clear();
+    return serialization::detail::try_deserialize_with_backend<tree_tag>(out, value, ctx,
+                                                                         status);
+}
+
+template <typename T, typename Context>
+void patch(T& out, const msgpack::value& value, Context& ctx)
+{
+    serialization::detail::patch_with_backend<tree_tag>(out, value, ctx);
+}
+
+template <typename T>
+void patch(T& out, const msgpack::value& value)
+{
+    deserialize_context ctx{};
+    msgpack::patch(out, value, ctx);
+}
+
+} // namespace kl::msgpack
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace kl::serialization {
+
+class deserialize_status;
+} // namespace kl::serialization
+
+namespace kl::msgpack {
+
+class value;
+class writer;
+
+class dump_context;
+class deserialize_context;
+
+template <typename T>
+std::vector<std::byte> dump(const T& obj);
+
+template <typename T, typename Context>
+void dump(const T& obj, Context& ctx);
+
+template <typename T>
+void deserialize(T& out, const msgpack::value& value);
+
+template <typename T, typename Context>
+void deserialize(T& out, const msgpack::value& value, Context& ctx);
+
+template <typename T>
+T deserialize(const msgpack::value& value);
+
+template <typename T, typename Context>
+T deserialize(const msgpack::value& value, Context& ctx);
+
+template <typename T>
+serialization::deserialize_status try_deserialize(T& out, const msgpack::value& value);
+
+template <typename T, typename Context>
+serialization::deserialize_status try_deserialize(T& out, const msgpack::value& value,
+                                                  Context& ctx);
+
+template <typename T, typename Context>
+bool try_deserialize(T& out, const msgpack::value& value, Context& ctx,
+                     serialization::deserialize_status& status);
+
+template <typename T>
+void patch(T& out, const msgpack::value& value);
+
+template <typename T, typename Context>
+void patch(T& out, const msgpack::value& value, Context& ctx);
+
+} // namespace kl::msgpack
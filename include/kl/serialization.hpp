@@ -46,6 +46,17 @@ namespace kl::serialization {
       from the built-in reflected fallback; types using it must also provide a
       matching `patch_adl()` to avoid reflected PATCH semantics.
 
+   3. try_deserialize() handles the built-in types without throwing. Types
+      with `serializer<T>::deserialize()` or a custom `deserialize_adl()` go
+      through it and the thrown deserialize_error is turned into the status.
+      As with PATCH, a custom `deserialize_adl()` can't be told apart from the
+      built-in one for reflectable structs, enums, ranges, tuples and
+      optionals. Such types, or any type wanting to avoid the exception,
+      should provide:
+
+          bool try_deserialize_adl(kl::json::tree_tag, T&, const rapidjson::Value&,
+                                   Context&, kl::serialization::deserialize_status&);
+
    Direct `kl::serialization::dump()/serialize()/deserialize()/patch()` calls
    require a context with `backend_type`. Backend wrappers such as
    `kl::json::dump()`, `kl::json::serialize()`, and `kl::json::deserialize()`
@@ -123,6 +134,48 @@ auto deserialize(T& out, const Value& value, Context& ctx, priority_tag<2>)
     serializer<T>::deserialize(out, value, ctx);
 }
 
+// Falls back to the throwing path for types without the non-throwing one
+// (user-provided serializer<T> or deserialize_adl())
+template <typename T, typename Backend, typename Value, typename Context>
+bool try_deserialize(T& out, const Value& value, Context& ctx, deserialize_status& status,
+                     priority_tag<0>)
+{
+    try
+    {
+        detail::deserialize<T, Backend>(out, value, ctx, priority_tag<2>{});
+        return true;
+    }
+    catch (deserialize_error& ex)
+    {
+        status.fail(std::string{ex.what()});
+        return false;
+    }
+}
+
+template <typename T, typename Backend, typename Value, typename Context>
+auto try_deserialize(T& out, const Value& value, Context& ctx, deserialize_status& status,
+                     priority_tag<1>)
+    -> decltype(detail::try_deserialize_adl<Backend>(out, value, ctx, status))
+{
+    return detail::try_deserialize_adl<Backend>(out, value, ctx, status);
+}
+
+template <typename T, typename Backend, typename Value, typename Context>
+auto try_deserialize(T& out, const Value& value, Context& ctx, deserialize_status& status,
+                     priority_tag<2>)
+    -> decltype(backend_traits<Backend>::try_deserialize(out, value, ctx, status))
+{
+    return backend_traits<Backend>::try_deserialize(out, value, ctx, status);
+}
+
+template <typename T, typename Backend, typename Value, typename Context>
+auto try_deserialize(T& out, const Value& value, Context& ctx, deserialize_status& status,
+                     priority_tag<3>)
+    -> decltype(serializer<T>::deserialize(out, value, ctx), bool())
+{
+    return detail::try_deserialize<T, Backend>(out, value, ctx, status, priority_tag<0>{});
+}
+
 template <typename T, typename Backend, typename Value, typename Context>
 void patch(T& out, const Value& value, Context& ctx, priority_tag<0>)
 {
@@ -188,6 +241,14 @@ void deserialize_with_backend(T& out, const Value& value, Context& ctx)
     detail::deserialize<T, backend>(out, value, ctx, priority_tag<2>{});
 }
 
+template <typename BackendIdentity, typename T, typename Value, typename Context>
+bool try_deserialize_with_backend(T& out, const Value& value, Context& ctx,
+                                  deserialize_status& status)
+{
+    using backend = backend_t<BackendIdentity>;
+    return detail::try_deserialize<T, backend>(out, value, ctx, status, priority_tag<3>{});
+}
+
 template <typename BackendIdentity, typename T, typename Value, typename Context>
 void patch_with_backend(T& out, const Value& value, Context& ctx)
 {
@@ -222,6 +283,17 @@ T deserialize(const Value& value, Context& ctx)
     return out;
 }
 
+// Same as deserialize() but failures are reported through the returned status
+// instead of throwing deserialize_error. `out` may be left partially filled.
+template <typename T, typename Value, typename Context>
+deserialize_status try_deserialize(T& out, const Value& value, Context& ctx)
+{
+    using backend = detail::backend_t<Context>;
+    deserialize_status status;
+    detail::try_deserialize<T, backend>(out, value, ctx, status, priority_tag<3>{});
+    return status;
+}
+
 template <typename T, typename Value, typename Context>
 void patch(T& out, const Value& value, Context& ctx)
 {
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <exception>
 #include <string>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 namespace kl::serialization {
 
@@ -47,4 +50,59 @@ private:
     std::string message_;
 };
 
+// Outcome of try_deserialize(). Instead of throwing deserialize_error (and
+// having each level catch it to extend its message) the failure is recorded
+// here together with the path leading to the offending value. The message,
+// formatted the same as deserialize_error::what(), is only put together when
+// asked for.
+class deserialize_status
+{
+public:
+    explicit operator bool() const noexcept { return !failed_; }
+    bool failed() const noexcept { return failed_; }
+
+    std::string message() const;
+    [[noreturn]] void raise() const;
+    void clear() noexcept;
+
+    // `reason` and `detail` (appended to the reason) must be string literals
+    // or otherwise outlive the status
+    void fail(const char* reason, const char* detail = nullptr) noexcept;
+    void fail(std::string reason);
+
+    // Records the path to the failed value, innermost first. Names given as
+    // const char* must outlive the status (e.g. reflected field names).
+    void add_field(const char* name);
+    void add_field(std::string name);
+    void add_extra_field(const char* name);
+    void add_extra_field(std::string name);
+    void add_element(std::size_t index);
+    void add_type(const std::type_info& type);
+
+private:
+    enum class crumb_kind : unsigned char
+    {
+        field,
+        extra_field,
+        element,
+        type
+    };
+
+    struct crumb
+    {
+        crumb_kind kind;
+        std::size_t index;
+        const char* name;
+        const std::type_info* type;
+        std::string owned_name;
+    };
+
+private:
+    bool failed_{false};
+    const char* reason_{""};
+    const char* detail_{nullptr};
+    std::string owned_reason_;
+    std::vector<crumb> path_;
+};
+
 } // namespace kl::serialization
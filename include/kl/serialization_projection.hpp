@@ -0,0 +1,170 @@
+#pragma once
+
+#include "kl/ctti.hpp"
+#include "kl/type_traits.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace kl::serialization {
+
+/*
+ * Reflectable view over a subset of Reflectable's fields. Only the selected
+ * members are visible to kl::ctti so (de)serialization never touches the rest:
+ * json::deserialize() doesn't descend into unselected members of the document,
+ * json::load() skips their subtrees without deserializing (or allocating for)
+ * them and json::dump() writes only the selected ones. Unselected members keep
+ * their default values.
+ *
+ * Sample usage:
+
+struct big_t
+{
+    std::string id;
+    int version;
+    std::vector<item_t> items; // huge
+    ...
+};
+KL_REFLECT_STRUCT(big_t, id, version, items, ...)
+
+using big_header_t = kl::serialization::projection<big_t, &big_t::id, &big_t::version>;
+
+auto header = kl::json::load<big_header_t>(text);
+std::cout << header->id << header->version;
+
+ * Members are selected by a pointer-to-member of a field reflected with
+ * KL_REFLECT_STRUCT (or one of its bases). Names, aliases and attributes of
+ * selected fields are the same as in Reflectable. Fields reflected through an
+ * accessor can't be selected.
+ */
+template <typename Reflectable, auto... Members>
+class projection
+{
+    static_assert(ctti::is_reflectable_v<Reflectable>,
+                  "projection requires a reflectable type (use KL_REFLECT_STRUCT)");
+    static_assert(sizeof...(Members) > 0, "projection requires at least one member");
+
+public:
+    using value_type = Reflectable;
+
+    projection() = default;
+    explicit projection(Reflectable value) : value_{std::move(value)} {}
+
+    Reflectable& get() & noexcept { return value_; }
+    const Reflectable& get() const& noexcept { return value_; }
+    Reflectable&& get() && noexcept { return std::move(value_); }
+
+    Reflectable& operator*() & noexcept { return value_; }
+    const Reflectable& operator*() const& noexcept { return value_; }
+    Reflectable* operator->() noexcept { return &value_; }
+    const Reflectable* operator->() const noexcept { return &value_; }
+
+    template <auto Ptr>
+    static constexpr bool is_selected() noexcept
+    {
+        return (same_member<Ptr, Members>() || ...);
+    }
+
+private:
+    template <auto Lhs, auto Rhs>
+    static constexpr bool same_member() noexcept
+    {
+        if constexpr (std::is_same_v<decltype(Lhs), decltype(Rhs)>)
+            return Lhs == Rhs;
+        else
+            return false;
+    }
+
+    // Wraps the factory given to reflect_struct_fields(). Selected fields are
+    // turned into accessors reaching into the wrapped object, the rest into a
+    // marker which is then dropped by the visitor below.
+    struct unselected_field {};
+
+    template <typename Factory>
+    struct field_factory
+    {
+        template <auto Ptr, typename... AttributeFactories>
+        constexpr auto field(const char* name, AttributeFactories... factories) const
+        {
+            if constexpr (is_selected<Ptr>())
+            {
+                return factory.accessor(
+                    name, [](auto& p) -> auto& { return p.get().*Ptr; },
+                    std::move(factories)...);
+            }
+            else
+            {
+                (void)name;
+                return unselected_field{};
+            }
+        }
+
+        template <typename Accessor, typename... AttributeFactories>
+        constexpr auto accessor(const char*, Accessor, AttributeFactories...) const
+        {
+            return unselected_field{};
+        }
+
+        Factory& factory;
+    };
+
+    template <typename Visitor>
+    struct field_visitor
+    {
+        template <typename Field>
+        constexpr void operator()(Field&& field) const
+        {
+            if constexpr (!std::is_same_v<remove_cvref_t<Field>, unselected_field>)
+                visitor(std::forward<Field>(field));
+        }
+
+        Visitor& visitor;
+    };
+
+    // Used to check that every member is a reflected field of Reflectable
+    struct counting_factory
+    {
+        template <auto Ptr, typename... AttributeFactories>
+        constexpr auto field(const char*, AttributeFactories...) const
+        {
+            return std::bool_constant<is_selected<Ptr>()>{};
+        }
+
+        template <typename Accessor, typename... AttributeFactories>
+        constexpr auto accessor(const char*, Accessor, AttributeFactories...) const
+        {
+            return std::false_type{};
+        }
+    };
+
+    static constexpr std::size_t num_selected_fields() noexcept
+    {
+        std::size_t count = 0;
+        reflect_struct_fields(
+            counting_factory{}, [&count](auto selected) { count += selected(); },
+            ctti::record<Reflectable>);
+        return count;
+    }
+
+    template <typename Factory, typename Visitor>
+    friend constexpr void reflect_struct_fields(Factory&& factory, Visitor&& vis,
+                                                ctti::record_class<projection>)
+    {
+        static_assert(num_selected_fields() == sizeof...(Members),
+                      "every projected member must be a distinct, reflected field of "
+                      "the underlying type");
+        reflect_struct_fields(field_factory<Factory>{factory}, field_visitor<Visitor>{vis},
+                              ctti::record<Reflectable>);
+    }
+
+    friend constexpr std::size_t reflect_num_fields(ctti::record_class<projection>) noexcept
+    {
+        return sizeof...(Members);
+    }
+
+private:
+    Reflectable value_{};
+};
+
+} // namespace kl::serialization
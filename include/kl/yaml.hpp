@@ -97,6 +97,14 @@ inline const YAML::Node& get_null_value()
 void expect_scalar(const YAML::Node& value);
 void expect_sequence(const YAML::Node& value);
 void expect_map(const YAML::Node& value);
+
+// Non-throwing counterparts of the above, used by try_deserialize()
+bool check_scalar(const YAML::Node& value, serialization::deserialize_status& status);
+bool check_sequence(const YAML::Node& value, serialization::deserialize_status& status);
+bool check_map(const YAML::Node& value, serialization::deserialize_status& status);
+
+// Reports YAML::BadConversion for given node, with the same message
+bool fail_bad_conversion(const YAML::Node& value, serialization::deserialize_status& status);
 } // namespace detail
 
 // Safely gets the YAML value from the YAML sequence. If provided index is
@@ -346,10 +354,22 @@ struct yaml_tree_backend
         serialization::detail::patch_with_backend<yaml::tree_tag>(out, value, ctx);
     }
 
+    template <typename T, typename Context>
+    static bool try_deserialize(T& out, const value_type& value, Context& ctx,
+                                serialization::deserialize_status& status)
+    {
+        return serialization::detail::try_deserialize_with_backend<yaml::tree_tag>(out, value,
+                                                                                  ctx, status);
+    }
+
     // Map stuff
 
     static value_type make_map() { return value_type{YAML::NodeType::Map}; }
     static void expect_map(const value_type& value) { detail::expect_map(value); }
+    static bool try_expect_map(const value_type& value, serialization::deserialize_status& status)
+    {
+        return detail::check_map(value, status);
+    }
     static bool is_map(const value_type& value) { return value.IsMap(); }
 
     template <typename Key, typename Context>
@@ -366,10 +386,17 @@ struct yaml_tree_backend
             visitor(obj.first, obj.second);
     }
 
+    static std::string_view field_key(const value_type& key) { return key.Scalar(); }
+
     // Sequence stuff
 
     static value_type make_sequence() { return value_type{YAML::NodeType::Sequence}; }
     static void expect_sequence(const value_type& value) { detail::expect_sequence(value); }
+    static bool try_expect_sequence(const value_type& value,
+                                    serialization::deserialize_status& status)
+    {
+        return detail::check_sequence(value, status);
+    }
     static bool is_sequence(const value_type& value) { return value.IsSequence(); }
 
     template <typename Context>
@@ -566,6 +593,49 @@ void deserialize_adl(yaml::tree_tag, yaml::view& out, const YAML::Node& value, C
     out = yaml::view{value};
 }
 
+// try_deserialize_adl implementations for simple types
+
+template <typename Arithmetic, typename Context,
+          enable_if<std::is_arithmetic<Arithmetic>> = true>
+bool try_deserialize_adl(yaml::tree_tag, Arithmetic& out, const YAML::Node& value, Context&,
+                         deserialize_status& status)
+{
+    if (!yaml::detail::check_scalar(value, status))
+        return false;
+    // Same conversion as YAML::Node::as<>() but without the exception
+    if (YAML::convert<Arithmetic>::decode(value, out))
+        return true;
+    return yaml::detail::fail_bad_conversion(value, status);
+}
+
+template <typename Context>
+bool try_deserialize_adl(yaml::tree_tag, std::string& out, const YAML::Node& value, Context&,
+                         deserialize_status& status)
+{
+    if (!yaml::detail::check_scalar(value, status))
+        return false;
+    out = value.Scalar();
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(yaml::tree_tag, std::string_view& out, const YAML::Node& value,
+                         Context&, deserialize_status& status)
+{
+    if (!yaml::detail::check_scalar(value, status))
+        return false;
+    out = value.Scalar();
+    return true;
+}
+
+template <typename Context>
+bool try_deserialize_adl(yaml::tree_tag, yaml::view& out, const YAML::Node& value, Context&,
+                         deserialize_status&)
+{
+    out = yaml::view{value};
+    return true;
+}
+
 // patch_adl implementation
 
 template <typename T, typename Context>
@@ -625,6 +695,14 @@ struct backend_traits<yaml::detail::yaml_tree_backend>
     {
         patch_adl(yaml::tree_tag{}, out, value, ctx);
     }
+
+    template <typename T, typename Context>
+    static auto try_deserialize(T& out, const YAML::Node& value, Context& ctx,
+                                deserialize_status& status)
+        -> decltype(try_deserialize_adl(yaml::tree_tag{}, out, value, ctx, status))
+    {
+        return try_deserialize_adl(yaml::tree_tag{}, out, value, ctx, status);
+    }
 };
 
 } // namespace kl::serialization
@@ -706,6 +784,34 @@ T deserialize(const YAML::Node& value, Context& ctx)
     return out;
 }
 
+// Same as deserialize() but failures are reported through the returned status
+// instead of exceptions (see json::try_deserialize()). On failure `out` may be
+// left partially filled.
+template <typename T>
+serialization::deserialize_status try_deserialize(T& out, const YAML::Node& value)
+{
+    deserialize_context ctx{};
+    return yaml::try_deserialize(out, value, ctx);
+}
+
+template <typename T, typename Context>
+serialization::deserialize_status try_deserialize(T& out, const YAML::Node& value, Context& ctx)
+{
+    serialization::deserialize_status status;
+    yaml::try_deserialize(out, value, ctx, status);
+    return status;
+}
+
+// Reuses `status` (e.g. across many calls) instead of returning a new one
+template <typename T, typename Context>
+bool try_deserialize(T& out, const YAML::Node& value, Context& ctx,
+                     serialization::deserialize_status& status)
+{
+    status.clear();
+    return serialization::detail::try_deserialize_with_backend<tree_tag>(out, value, ctx,
+                                                                         status);
+}
+
 template <typename T, typename Context>
 void patch(T& out, const YAML::Node& value, Context& ctx)
 {
@@ -7,6 +7,11 @@ namespace YAML {
 class Node;
 }
 
+namespace kl::serialization {
+
+class deserialize_status;
+} // namespace kl::serialization
+
 namespace kl::yaml {
 
 class view;
@@ -40,6 +45,17 @@ T deserialize(const YAML::Node& value);
 template <typename T, typename Context>
 T deserialize(const YAML::Node& value, Context& ctx);
 
+template <typename T>
+serialization::deserialize_status try_deserialize(T& out, const YAML::Node& value);
+
+template <typename T, typename Context>
+serialization::deserialize_status try_deserialize(T& out, const YAML::Node& value,
+                                                  Context& ctx);
+
+template <typename T, typename Context>
+bool try_deserialize(T& out, const YAML::Node& value, Context& ctx,
+                     serialization::deserialize_status& status);
+
 template <typename T>
 void patch(T& out, const YAML::Node& value);
 
@@ -0,0 +1,83 @@
+#pragma once
+
+// Runtime CPU feature detection shared by binary_rw's SIMD kernels. Not part
+// of the public headers.
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define KL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need the instruction set enabled per function since the
+// library itself is built for the baseline target. MSVC emits any intrinsic.
+#if defined(__GNUC__) || defined(__clang__)
+#define KL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define KL_TARGET(isa)
+#endif
+
+#if defined(KL_X86)
+
+namespace kl::detail {
+
+#if defined(_MSC_VER) && !defined(__clang__)
+
+inline bool cpu_has_avx2() noexcept
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The OS must also save the YMM registers on context switches
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+inline bool cpu_has_ssse3() noexcept
+{
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+}
+
+inline bool cpu_has_sse42() noexcept
+{
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+}
+
+#else
+
+inline bool cpu_has_avx2() noexcept
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+inline bool cpu_has_ssse3() noexcept
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+
+inline bool cpu_has_sse42() noexcept
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+#endif
+} // namespace kl::detail
+
+#endif
@@ -0,0 +1,136 @@
+#include "kl/binary_rw/endian.hpp"
+#include "cpu_features.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace kl::detail {
+
+namespace {
+
+template <typename UInt>
+void reverse_scalar(std::byte* dst, const std::byte* src, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        UInt value;
+        std::memcpy(&value, src + i * sizeof(UInt), sizeof(UInt));
+        value = boost::endian::endian_reverse(value);
+        std::memcpy(dst + i * sizeof(UInt), &value, sizeof(UInt));
+    }
+}
+
+void reverse_scalar(std::byte* dst, const std::byte* src, std::size_t count,
+                    std::size_t size) noexcept
+{
+    switch (size)
+    {
+    case 2:
+        return reverse_scalar<std::uint16_t>(dst, src, count);
+    case 4:
+        return reverse_scalar<std::uint32_t>(dst, src, count);
+    case 8:
+        return reverse_scalar<std::uint64_t>(dst, src, count);
+    }
+}
+
+#if defined(KL_X86)
+
+// pshufb masks reversing each 2, 4 or 8 byte group. vpshufb shuffles within
+// 128-bit lanes so the same pattern is repeated for the upper lane.
+template <std::size_t Size>
+constexpr std::array<std::uint8_t, 32> make_shuffle_mask() noexcept
+{
+    std::array<std::uint8_t, 32> mask{};
+    for (std::size_t i = 0; i < mask.size(); ++i)
+        mask[i] = static_cast<std::uint8_t>((i % 16) / Size * Size + (Size - 1 - i % Size));
+    return mask;
+}
+
+alignas(32) constexpr std::array<std::uint8_t, 32> shuffle_masks[] = {
+    make_shuffle_mask<2>(), make_shuffle_mask<4>(), make_shuffle_mask<8>()};
+
+const std::uint8_t* shuffle_mask(std::size_t size) noexcept
+{
+    return shuffle_masks[size == 2 ? 0 : size == 4 ? 1 : 2].data();
+}
+
+KL_TARGET("ssse3")
+void reverse_ssse3(std::byte* dst, const std::byte* src, std::size_t count,
+                   std::size_t size) noexcept
+{
+    const auto mask = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_mask(size)));
+    const auto bytes = count * size;
+    std::size_t i = 0;
+
+    for (; i + 16 <= bytes; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+
+    reverse_scalar(dst + i, src + i, (bytes - i) / size, size);
+}
+
+KL_TARGET("avx2")
+void reverse_avx2(std::byte* dst, const std::byte* src, std::size_t count,
+                  std::size_t size) noexcept
+{
+    const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle_mask(size)));
+    const auto bytes = count * size;
+    std::size_t i = 0;
+
+    // Two independent shuffles per iteration to hide the load latency
+    for (; i + 64 <= bytes; i += 64)
+    {
+        const auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v0, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32),
+                            _mm256_shuffle_epi8(v1, mask));
+    }
+
+    for (; i + 32 <= bytes; i += 32)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+
+    reverse_scalar(dst + i, src + i, (bytes - i) / size, size);
+}
+
+#endif
+
+} // namespace
+
+gsl::span<const reverse_bytes_kernel> reverse_bytes_kernels() noexcept
+{
+    static const auto kernels = [] {
+        std::array<reverse_bytes_kernel, 3> ret{&reverse_scalar};
+        std::size_t count = 1;
+#if defined(KL_X86)
+        if (cpu_has_ssse3())
+            ret[count++] = &reverse_ssse3;
+        if (cpu_has_avx2())
+            ret[count++] = &reverse_avx2;
+#endif
+        return std::pair{ret, count};
+    }();
+    return {kernels.first.data(), kernels.second};
+}
+
+void reverse_bytes_copy(std::byte* dst, const std::byte* src, std::size_t count,
+                        std::size_t size) noexcept
+{
+    static const auto reverse = [] {
+        const auto kernels = reverse_bytes_kernels();
+        return kernels[kernels.size() - 1];
+    }();
+    reverse(dst, src, count, size);
+}
+} // namespace kl::detail
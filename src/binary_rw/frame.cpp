@@ -0,0 +1,182 @@
+#include "kl/binary_rw/frame.hpp"
+#include "cpu_features.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace kl {
+
+namespace {
+
+// Reflected Castagnoli polynomial
+constexpr std::uint32_t crc32c_polynomial = 0x82F63B78;
+
+using crc32c_table = std::array<std::array<std::uint32_t, 256>, 8>;
+
+// tables[0] is the classic byte-at-a-time table, tables[k] advances the CRC of
+// a byte by another k zero bytes so that 8 lookups process 8 bytes at once
+constexpr crc32c_table make_crc32c_tables() noexcept
+{
+    crc32c_table tables{};
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        auto crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (crc & 1 ? crc32c_polynomial : 0);
+        tables[0][i] = crc;
+    }
+
+    for (std::size_t k = 1; k < tables.size(); ++k)
+    {
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+            const auto prev = tables[k - 1][i];
+            tables[k][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr crc32c_table crc32c_tables = make_crc32c_tables();
+
+std::uint32_t load_little_u32(const std::byte* data) noexcept
+{
+    return boost::endian::load_little_u32(reinterpret_cast<const unsigned char*>(data));
+}
+
+std::uint32_t crc32c_slicing_by_8(const std::byte* data, std::size_t size,
+                                  std::uint32_t crc) noexcept
+{
+    const auto& t = crc32c_tables;
+
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        const auto lo = load_little_u32(data) ^ crc;
+        const auto hi = load_little_u32(data + 4);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+    }
+
+    for (; size > 0; --size, ++data)
+        crc = (crc >> 8) ^ t[0][(crc ^ std::to_integer<std::uint32_t>(*data)) & 0xFF];
+
+    return crc;
+}
+
+#if defined(KL_X86)
+
+KL_TARGET("sse4.2")
+std::uint32_t crc32c_sse42(const std::byte* data, std::size_t size, std::uint32_t crc) noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    std::uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        std::uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = static_cast<std::uint32_t>(crc64);
+#endif
+
+    for (; size >= 4; size -= 4, data += 4)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc = _mm_crc32_u32(crc, value);
+    }
+
+    for (; size > 0; --size, ++data)
+        crc = _mm_crc32_u8(crc, std::to_integer<unsigned char>(*data));
+
+    return crc;
+}
+
+#endif
+
+std::uint32_t frame_checksum(std::uint32_t length, gsl::span<const std::byte> payload) noexcept
+{
+    const auto crc = crc32c(gsl::as_bytes(gsl::span<const std::uint32_t, 1>{&length, 1}));
+    return crc32c(payload, crc);
+}
+} // namespace
+
+namespace detail {
+
+gsl::span<const crc32c_kernel> crc32c_kernels() noexcept
+{
+    static const auto kernels = [] {
+        std::array<crc32c_kernel, 2> ret{&crc32c_slicing_by_8};
+        std::size_t count = 1;
+#if defined(KL_X86)
+        if (cpu_has_sse42())
+            ret[count++] = &crc32c_sse42;
+#endif
+        return std::pair{ret, count};
+    }();
+    return {kernels.first.data(), kernels.second};
+}
+} // namespace detail
+
+std::uint32_t crc32c(gsl::span<const std::byte> data, std::uint32_t crc) noexcept
+{
+    static const auto update = [] {
+        const auto kernels = detail::crc32c_kernels();
+        return kernels[kernels.size() - 1];
+    }();
+    return ~update(data.data(), data.size(), ~crc);
+}
+
+std::size_t begin_frame(binary_writer& w) noexcept
+{
+    const auto frame = w.pos();
+    w.span(frame_header_size);
+    w.suspend_references();
+    return frame;
+}
+
+bool end_frame(binary_writer& w, std::size_t frame) noexcept
+{
+    w.resume_references();
+    if (w.err())
+        return false;
+
+    const auto written = w.written();
+    if (frame + frame_header_size > written.size() ||
+        written.size() - frame - frame_header_size > std::numeric_limits<std::uint32_t>::max())
+    {
+        w.notify_error();
+        return false;
+    }
+
+    const auto payload = written.subspan(frame + frame_header_size);
+    const auto length = static_cast<std::uint32_t>(payload.size());
+    const auto checksum = frame_checksum(length, payload);
+
+    std::memcpy(written.data() + frame, &length, sizeof(length));
+    std::memcpy(written.data() + frame + sizeof(length), &checksum, sizeof(checksum));
+    return true;
+}
+
+std::optional<binary_reader> read_frame(binary_reader& r) noexcept
+{
+    const auto length = r.read<std::uint32_t>();
+    const auto checksum = r.read<std::uint32_t>();
+    const auto payload = r.span(length);
+    if (r.err())
+        return std::nullopt;
+
+    // The length is covered too so that a damaged one is caught before the
+    // payload is decoded, though it will still misplace the next frame
+    if (frame_checksum(length, payload) != checksum)
+        return std::nullopt;
+
+    binary_reader ret{payload};
+    ret.set_encoding(r.encoding());
+    return ret;
+}
+} // namespace kl
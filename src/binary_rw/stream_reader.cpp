@@ -0,0 +1,96 @@
+#include "kl/binary_rw/stream_reader.hpp"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+namespace kl {
+
+namespace {
+
+// Room for at least the longest varint
+constexpr std::size_t min_capacity = 64;
+
+std::ptrdiff_t read_fd(int fd, gsl::span<std::byte> buffer) noexcept
+{
+#if defined(_WIN32)
+    const auto size = static_cast<unsigned>((std::min)(buffer.size(), std::size_t{INT_MAX}));
+    return ::_read(fd, buffer.data(), size);
+#else
+    for (;;)
+    {
+        const auto ret = ::read(fd, buffer.data(), buffer.size());
+        if (ret >= 0 || errno != EINTR)
+            return ret;
+    }
+#endif
+}
+} // namespace
+
+stream_binary_reader::stream_binary_reader(source_function source, std::size_t capacity)
+    : binary_reader{gsl::span<const std::byte>{}, &refill},
+      source_{std::move(source)},
+      storage_((std::max)(capacity, min_capacity))
+{
+}
+
+stream_binary_reader::stream_binary_reader(int fd, std::size_t capacity)
+    : stream_binary_reader{[fd](gsl::span<std::byte> buffer) { return read_fd(fd, buffer); },
+                           capacity}
+{
+}
+
+bool stream_binary_reader::at_end() noexcept
+{
+    return left() == 0 && !refill(*this, 1);
+}
+
+bool stream_binary_reader::refill(binary_reader& r, std::size_t size) noexcept
+{
+    auto& self = static_cast<stream_binary_reader&>(r);
+    auto* data = self.storage_.data();
+    auto filled = self.left();
+
+    // Make room at the back by moving still unread bytes to the front
+    if (self.pos_ != 0)
+    {
+        if (filled)
+            std::memmove(data, data + self.pos_, filled);
+        self.consumed_ += self.pos_;
+        self.pos_ = 0;
+    }
+
+    while (filled < size && filled < self.storage_.size() && !self.eof_)
+    {
+        std::ptrdiff_t ret = -1;
+        try
+        {
+            ret = self.source_({data + filled, self.storage_.size() - filled});
+        }
+        catch (...)
+        {
+            // Reported like a source error, the reader itself never throws
+        }
+
+        if (ret <= 0)
+        {
+            self.eof_ = true;
+            if (ret < 0)
+                self.err_ = true;
+            break;
+        }
+        filled += static_cast<std::size_t>(ret);
+    }
+
+    self.buffer_ = {data, filled};
+    return filled >= size;
+}
+} // namespace kl
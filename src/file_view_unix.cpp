@@ -5,6 +5,7 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <system_error>
 #include <cassert>
 #include <cstddef>
@@ -60,9 +61,43 @@ private:
 {
     throw std::system_error{static_cast<int>(errno), std::system_category()};
 }
+
+std::size_t page_size() noexcept
+{
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+int madvise_access(file_access access) noexcept
+{
+    switch (access)
+    {
+    case file_access::sequential:
+        return MADV_SEQUENTIAL;
+    case file_access::random:
+        return MADV_RANDOM;
+    default:
+        return MADV_NORMAL;
+    }
+}
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+int fadvise_access(file_access access) noexcept
+{
+    switch (access)
+    {
+    case file_access::sequential:
+        return POSIX_FADV_SEQUENTIAL;
+    case file_access::random:
+        return POSIX_FADV_RANDOM;
+    default:
+        return POSIX_FADV_NORMAL;
+    }
+}
+#endif
 } // namespace
 
-file_view::file_view(const char* file_path)
+file_view::file_view(const char* file_path, const file_view_options& opts)
 {
     file_descriptor fd{::open(file_path, O_RDONLY)};
     if (!fd)
@@ -75,13 +110,45 @@ file_view::file_view(const char* file_path)
     if (!file_info.st_size)
         return; // Empty file
 
-    void* mapped = ::mmap(nullptr, static_cast<std::size_t>(file_info.st_size),
-                          PROT_READ, MAP_PRIVATE, fd, 0);
-    if (!mapped)
+    const auto size = static_cast<std::size_t>(file_info.st_size);
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    // Page cache read-ahead of the underlying file (the larger window for
+    // sequential access is what keeps a cold scan close to disk bandwidth)
+    if (opts.access != file_access::normal)
+        ::posix_fadvise(fd, 0, 0, fadvise_access(opts.access));
+#endif
+
+    int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+    if (opts.populate)
+        flags |= MAP_POPULATE;
+#endif
+
+    void* mapped = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    if (mapped == MAP_FAILED)
         throw_system_error();
 
-    contents_ = gsl::span{static_cast<const std::byte*>(mapped),
-                          static_cast<std::size_t>(file_info.st_size)};
+    if (opts.access != file_access::normal)
+        ::madvise(mapped, size, madvise_access(opts.access));
+#if defined(MADV_HUGEPAGE)
+    if (opts.huge_pages)
+        ::madvise(mapped, size, MADV_HUGEPAGE);
+#endif
+#if !defined(MAP_POPULATE)
+    if (opts.populate)
+        ::madvise(mapped, size, MADV_WILLNEED);
+#endif
+
+    if (opts.lock && ::mlock(mapped, size) == -1)
+    {
+        const auto error = errno;
+        ::munmap(mapped, size);
+        errno = error;
+        throw_system_error();
+    }
+
+    contents_ = gsl::span{static_cast<const std::byte*>(mapped), size};
 }
 
 file_view::~file_view()
@@ -92,4 +159,16 @@ file_view::~file_view()
                  contents_.size_bytes());
     }
 }
+
+void file_view::prefetch(std::size_t offset, std::size_t length) const noexcept
+{
+    if (offset >= contents_.size())
+        return;
+    length = (std::min)(length, contents_.size() - offset);
+
+    // madvise() wants a page aligned address
+    const auto begin = offset - offset % page_size();
+    ::madvise(const_cast<std::byte*>(contents_.data()) + begin, length + (offset - begin),
+              MADV_WILLNEED);
+}
 } // namespace kl
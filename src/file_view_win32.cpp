@@ -1,5 +1,6 @@
 #include "kl/file_view.hpp"
 
+#include <algorithm>
 #include <system_error>
 #include <cassert>
 
@@ -68,20 +69,48 @@ struct invalid_handle_value_policy
     throw std::system_error{static_cast<int>(::GetLastError()),
                             std::system_category()};
 }
+
+DWORD access_flags(file_access access) noexcept
+{
+    switch (access)
+    {
+    case file_access::sequential:
+        return FILE_FLAG_SEQUENTIAL_SCAN;
+    case file_access::random:
+        return FILE_FLAG_RANDOM_ACCESS;
+    default:
+        return 0x0;
+    }
+}
+
+void prefetch_range(const void* address, std::size_t size) noexcept
+{
+#if _WIN32_WINNT >= _WIN32_WINNT_WIN8
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<void*>(address), size};
+    ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#else
+    (void)address;
+    (void)size;
+#endif
+}
 } // namespace
 
-file_view::file_view(const char* file_path)
+// There are no huge pages for file mappings on Windows, opts.huge_pages is
+// ignored
+file_view::file_view(const char* file_path, const file_view_options& opts)
 {
+    const auto flags = access_flags(opts.access);
+
     handle<invalid_handle_value_policy> file_handle{
         ::CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr,
-                      OPEN_EXISTING, 0x0, nullptr)};
+                      OPEN_EXISTING, flags, nullptr)};
     if (!file_handle)
     {
         // Try again with RW sharing as the target file might be already be
         // opened in this mode.
         file_handle = ::CreateFileA(file_path, GENERIC_READ,
                                     FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
-                                    OPEN_EXISTING, 0x0, nullptr);
+                                    OPEN_EXISTING, flags, nullptr);
         if (!file_handle)
             throw_system_error();
     }
@@ -101,8 +130,20 @@ file_view::file_view(const char* file_path)
     if (!file_view)
         throw_system_error();
 
-    contents_ = gsl::span{static_cast<const std::byte*>(file_view),
-                          static_cast<std::size_t>(file_size.QuadPart)};
+    const auto size = static_cast<std::size_t>(file_size.QuadPart);
+
+    if (opts.populate)
+        prefetch_range(file_view, size);
+
+    if (opts.lock && !::VirtualLock(file_view, size))
+    {
+        const auto error = ::GetLastError();
+        ::UnmapViewOfFile(file_view);
+        ::SetLastError(error);
+        throw_system_error();
+    }
+
+    contents_ = gsl::span{static_cast<const std::byte*>(file_view), size};
 }
 
 file_view::~file_view()
@@ -110,4 +151,13 @@ file_view::~file_view()
     if (!contents_.empty())
         ::UnmapViewOfFile(contents_.data());
 }
+
+void file_view::prefetch(std::size_t offset, std::size_t length) const noexcept
+{
+    if (offset >= contents_.size())
+        return;
+    length = (std::min)(length, contents_.size() - offset);
+
+    prefetch_range(contents_.data() + offset, length);
+}
 } // namespace kl
@@ -5,6 +5,11 @@
 
 #include <rapidjson/document.h>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <memory>
 #include <string>
 
 namespace rapidjson {
@@ -15,6 +20,150 @@ KL_REFLECT_ENUM(Type, kNullType, kFalseType, kTrueType, kObjectType, kArrayType,
 
 namespace kl::json {
 
+arena::pool::pool(std::size_t capacity)
+    : block{std::make_unique<char[]>(capacity)}, size{capacity}
+{
+    alloc.emplace(block.get(), size);
+    usable = alloc->Capacity();
+}
+
+bool arena::pool::clear()
+{
+    const auto required = alloc->Capacity();
+    if (required <= usable)
+    {
+        alloc->Clear();
+        return false;
+    }
+
+    // Last cycle needed extra chunks. Drop them and regrow the block so the
+    // same workload fits in it next time.
+    const auto overhead = size - usable;
+    auto new_size = size;
+    while (new_size < required + overhead)
+        new_size *= 2;
+
+    alloc.reset();
+    block = std::make_unique<char[]>(new_size);
+    size = new_size;
+    alloc.emplace(block.get(), size);
+    usable = alloc->Capacity();
+    return true;
+}
+
+arena::arena(std::size_t capacity)
+    : values_{std::max<std::size_t>(capacity, 1024)},
+      stack_{std::max<std::size_t>(capacity / 4, 1024)},
+      writer_{buffer_}
+{
+    make_document();
+}
+
+arena::writer_type& arena::writer()
+{
+    buffer_.Clear();
+    writer_.Reset(buffer_);
+    return writer_;
+}
+
+void arena::reset()
+{
+    doc_.reset();
+    values_.clear();
+    stack_.clear();
+    make_document();
+    buffer_.Clear();
+}
+
+void arena::make_document()
+{
+    constexpr std::size_t stack_capacity = 1024;
+    doc_.emplace(&*values_.alloc, stack_capacity, &*stack_.alloc);
+}
+
+bool string_writer::Double(double d)
+{
+    if (!std::isfinite(d))
+        return false;
+
+    prefix();
+    char buf[32];
+    const auto result = std::to_chars(std::begin(buf), std::end(buf), d);
+    const auto length = static_cast<std::size_t>(result.ptr - buf);
+    buffer_.append(buf, length);
+    // Keep it a floating point number when read back, like rapidjson does
+    if (std::find_if(buf, result.ptr, [](char c) { return c == '.' || c == 'e'; }) == result.ptr)
+        buffer_.append(".0", 2);
+    return true;
+}
+
+std::string string_writer::release()
+{
+    std::string ret = std::move(buffer_);
+    Reset();
+    return ret;
+}
+
+void string_writer::Reset()
+{
+    buffer_.clear();
+    levels_.clear();
+    has_root_ = false;
+}
+
+namespace {
+
+// Same escaping as rapidjson::Writer: 0 - as is, 'u' - \u00XX, otherwise the
+// character following the backslash
+constexpr std::array<char, 256> make_escape_table()
+{
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; ++c)
+        table[c] = 'u';
+    table['\b'] = 'b';
+    table['\t'] = 't';
+    table['\n'] = 'n';
+    table['\f'] = 'f';
+    table['\r'] = 'r';
+    table['"'] = '"';
+    table['\\'] = '\\';
+    return table;
+}
+
+constexpr auto escape_table = make_escape_table();
+} // namespace
+
+void string_writer::write_string(const Ch* str, std::size_t length)
+{
+    buffer_.push_back('"');
+
+    const Ch* run = str;
+    const Ch* const end = str + length;
+    for (const Ch* p = str; p != end; ++p)
+    {
+        const auto c = static_cast<unsigned char>(*p);
+        const char esc = escape_table[c];
+        if (!esc)
+            continue;
+
+        buffer_.append(run, p);
+        run = p + 1;
+        if (esc == 'u')
+        {
+            constexpr char hex_digits[] = "0123456789ABCDEF";
+            const char seq[] = {'\\', 'u', '0', '0', hex_digits[c >> 4], hex_digits[c & 0xF]};
+            buffer_.append(seq, sizeof(seq));
+        }
+        else
+        {
+            const char seq[] = {'\\', esc};
+            buffer_.append(seq, sizeof(seq));
+        }
+    }
+    buffer_.append(run, end);
+    buffer_.push_back('"');
+}
+
 namespace detail {
 
 std::string type_name(const rapidjson::Value& value)
@@ -69,5 +218,48 @@ void expect_array(const rapidjson::Value& value)
 
     throw serialization::deserialize_error{"type must be an array but is a " + type_name(value)};
 }
+
+namespace {
+
+bool fail_type_check(const char* reason, const rapidjson::Value& value,
+                     serialization::deserialize_status& status)
+{
+    status.fail(reason, kl::to_string(value.GetType()));
+    return false;
+}
+} // namespace
+
+bool check_integral(const rapidjson::Value& value, serialization::deserialize_status& status)
+{
+    if (value.IsInt() || value.IsInt64() || value.IsUint() || value.IsUint64())
+        return true;
+    return fail_type_check("type must be an integral but is a ", value, status);
+}
+
+bool check_number(const rapidjson::Value& value, serialization::deserialize_status& status)
+{
+    return value.IsNumber() || fail_type_check("type must be a number but is a ", value, status);
+}
+
+bool check_boolean(const rapidjson::Value& value, serialization::deserialize_status& status)
+{
+    return value.IsBool() || fail_type_check("type must be a boolean but is a ", value, status);
+}
+
+bool check_string(const rapidjson::Value& value, serialization::deserialize_status& status)
+{
+    return value.IsString() || fail_type_check("type must be a string but is a ", value, status);
+}
+
+bool check_object(const rapidjson::Value& value, serialization::deserialize_status& status)
+{
+    return value.IsObject() ||
+           fail_type_check("type must be an object but is a ", value, status);
+}
+
+bool check_array(const rapidjson::Value& value, serialization::deserialize_status& status)
+{
+    return value.IsArray() || fail_type_check("type must be an array but is a ", value, status);
+}
 } // namespace detail
 } // namespace kl::json
@@ -0,0 +1,733 @@
+#include "kl/msgpack.hpp"
+#include "kl/serialization_error.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace kl::msgpack {
+
+namespace detail {
+
+namespace {
+
+template <typename T>
+T load_big(const std::byte* data) noexcept
+{
+    T v;
+    std::memcpy(&v, data, sizeof(T));
+    return boost::endian::big_to_native(v);
+}
+
+template <typename T>
+void store_big(std::byte* data, T v) noexcept
+{
+    boost::endian::native_to_big_inplace(v);
+    std::memcpy(data, &v, sizeof(T));
+}
+
+struct header
+{
+    msgpack::type type;
+    // Marker byte plus the length (and extension type) bytes following it
+    std::size_t header_size;
+    // Bytes following the header, not including children
+    std::uint64_t payload_size;
+    // Values nested directly in an array or a map (two per map member)
+    std::uint64_t children;
+};
+
+constexpr std::uint8_t marker_of(const std::byte* data) noexcept
+{
+    return static_cast<std::uint8_t>(*data);
+}
+
+// Length (or count) field of `size` bytes right after the marker
+std::uint64_t load_length(const std::byte* data, std::size_t size) noexcept
+{
+    switch (size)
+    {
+    case 1:
+        return load_big<std::uint8_t>(data + 1);
+    case 2:
+        return load_big<std::uint16_t>(data + 1);
+    default:
+        return load_big<std::uint32_t>(data + 1);
+    }
+}
+
+// Decodes the header of the value starting at `data` without reading past
+// `available` bytes. Returns false on truncated header or invalid marker.
+bool read_header(const std::byte* data, std::size_t available, header& h) noexcept
+{
+    if (available < 1)
+        return false;
+
+    const auto marker = marker_of(data);
+    h.header_size = 1;
+    h.payload_size = 0;
+    h.children = 0;
+
+    if (marker <= 0x7f || marker >= 0xe0)
+    {
+        h.type = msgpack::type::integer;
+        return true;
+    }
+    if (marker <= 0x8f)
+    {
+        h.type = msgpack::type::map;
+        h.children = 2 * (marker & 0x0f);
+        return true;
+    }
+    if (marker <= 0x9f)
+    {
+        h.type = msgpack::type::array;
+        h.children = marker & 0x0f;
+        return true;
+    }
+    if (marker <= 0xbf)
+    {
+        h.type = msgpack::type::string;
+        h.payload_size = marker & 0x1f;
+        return true;
+    }
+
+    // Variable sized length field following the marker (if any)
+    const auto with_length = [&](msgpack::type type, std::size_t length_size) {
+        h.type = type;
+        h.header_size = 1 + length_size;
+        if (available < h.header_size)
+            return false;
+        h.payload_size = load_length(data, length_size);
+        return true;
+    };
+
+    switch (marker)
+    {
+    case 0xc0:
+        h.type = msgpack::type::nil;
+        return true;
+    case 0xc2:
+    case 0xc3:
+        h.type = msgpack::type::boolean;
+        return true;
+    case 0xc4:
+    case 0xc5:
+    case 0xc6:
+        return with_length(msgpack::type::binary, std::size_t{1} << (marker - 0xc4));
+    case 0xc7:
+    case 0xc8:
+    case 0xc9:
+        // Extension type byte comes after the length
+        if (!with_length(msgpack::type::extension, std::size_t{1} << (marker - 0xc7)))
+            return false;
+        ++h.header_size;
+        return available >= h.header_size;
+    case 0xca:
+        h.type = msgpack::type::floating;
+        h.payload_size = 4;
+        return true;
+    case 0xcb:
+        h.type = msgpack::type::floating;
+        h.payload_size = 8;
+        return true;
+    case 0xcc:
+    case 0xcd:
+    case 0xce:
+    case 0xcf:
+        h.type = msgpack::type::integer;
+        h.payload_size = std::size_t{1} << (marker - 0xcc);
+        return true;
+    case 0xd0:
+    case 0xd1:
+    case 0xd2:
+    case 0xd3:
+        h.type = msgpack::type::integer;
+        h.payload_size = std::size_t{1} << (marker - 0xd0);
+        return true;
+    case 0xd4:
+    case 0xd5:
+    case 0xd6:
+    case 0xd7:
+    case 0xd8:
+        h.type = msgpack::type::extension;
+        h.header_size = 2;
+        h.payload_size = std::size_t{1} << (marker - 0xd4);
+        return available >= h.header_size;
+    case 0xd9:
+    case 0xda:
+    case 0xdb:
+        return with_length(msgpack::type::string, std::size_t{1} << (marker - 0xd9));
+    case 0xdc:
+    case 0xdd:
+        if (!with_length(msgpack::type::array, std::size_t{2} << (marker - 0xdc)))
+            return false;
+        h.children = h.payload_size;
+        h.payload_size = 0;
+        return true;
+    case 0xde:
+    case 0xdf:
+        if (!with_length(msgpack::type::map, std::size_t{2} << (marker - 0xde)))
+            return false;
+        h.children = 2 * h.payload_size;
+        h.payload_size = 0;
+        return true;
+    default: // 0xc1 is never used
+        return false;
+    }
+}
+
+header decode(const std::byte* data) noexcept
+{
+    header h;
+    read_header(data, static_cast<std::size_t>(-1), h);
+    return h;
+}
+} // namespace
+
+const std::byte* skip(const std::byte* data) noexcept
+{
+    // No recursion needed: just count how many values are still to be skipped
+    std::uint64_t pending = 1;
+    while (pending--)
+    {
+        const auto h = decode(data);
+        data += h.header_size + h.payload_size;
+        pending += h.children;
+    }
+    return data;
+}
+
+const std::byte* first_child(const std::byte* data) noexcept
+{
+    return data + decode(data).header_size;
+}
+
+std::string type_name(const msgpack::value& value)
+{
+    return kl::to_string(value.type());
+}
+
+void expect_integer(const msgpack::value& value)
+{
+    if (value.type() == msgpack::type::integer)
+        return;
+
+    throw serialization::deserialize_error{"type must be an integer but is a " +
+                                           type_name(value)};
+}
+
+void expect_number(const msgpack::value& value)
+{
+    const auto t = value.type();
+    if (t == msgpack::type::integer || t == msgpack::type::floating)
+        return;
+
+    throw serialization::deserialize_error{"type must be a number but is a " + type_name(value)};
+}
+
+void expect_boolean(const msgpack::value& value)
+{
+    if (value.type() == msgpack::type::boolean)
+        return;
+
+    throw serialization::deserialize_error{"type must be a boolean but is a " +
+                                           type_name(value)};
+}
+
+void expect_string(const msgpack::value& value)
+{
+    if (value.is_string())
+        return;
+
+    throw serialization::deserialize_error{"type must be a string but is a " + type_name(value)};
+}
+
+void expect_map(const msgpack::value& value)
+{
+    if (value.is_map())
+        return;
+
+    throw serialization::deserialize_error{"type must be a map but is a " + type_name(value)};
+}
+
+void expect_array(const msgpack::value& value)
+{
+    if (value.is_array())
+        return;
+
+    throw serialization::deserialize_error{"type must be an array but is a " + type_name(value)};
+}
+
+void throw_lossy_conversion()
+{
+    throw serialization::deserialize_error{"value cannot be losslessly stored in the variable"};
+}
+
+namespace {
+
+bool fail_type_check(const char* reason, const msgpack::value& value,
+                     serialization::deserialize_status& status)
+{
+    status.fail(reason, kl::to_string(value.type()));
+    return false;
+}
+} // namespace
+
+bool check_integer(const msgpack::value& value, serialization::deserialize_status& status)
+{
+    return value.type() == msgpack::type::integer ||
+           fail_type_check("type must be an integer but is a ", value, status);
+}
+
+bool check_number(const msgpack::value& value, serialization::deserialize_status& status)
+{
+    const auto t = value.type();
+    return t == msgpack::type::integer || t == msgpack::type::floating ||
+           fail_type_check("type must be a number but is a ", value, status);
+}
+
+bool check_boolean(const msgpack::value& value, serialization::deserialize_status& status)
+{
+    return value.type() == msgpack::type::boolean ||
+           fail_type_check("type must be a boolean but is a ", value, status);
+}
+
+bool check_string(const msgpack::value& value, serialization::deserialize_status& status)
+{
+    return value.is_string() || fail_type_check("type must be a string but is a ", value, status);
+}
+
+bool check_map(const msgpack::value& value, serialization::deserialize_status& status)
+{
+    return value.is_map() || fail_type_check("type must be a map but is a ", value, status);
+}
+
+bool check_array(const msgpack::value& value, serialization::deserialize_status& status)
+{
+    return value.is_array() || fail_type_check("type must be an array but is a ", value, status);
+}
+
+bool fail_lossy_conversion(serialization::deserialize_status& status)
+{
+    status.fail("value cannot be losslessly stored in the variable");
+    return false;
+}
+} // namespace detail
+
+msgpack::type value::type() const noexcept
+{
+    return detail::decode(data_).type;
+}
+
+bool value::is_int64() const noexcept
+{
+    const auto marker = detail::marker_of(data_);
+    if (marker == 0xcf)
+        return detail::load_big<std::uint64_t>(data_ + 1) <=
+               static_cast<std::uint64_t>((std::numeric_limits<std::int64_t>::max)());
+    return type() == msgpack::type::integer;
+}
+
+bool value::is_uint64() const noexcept
+{
+    const auto marker = detail::marker_of(data_);
+    if (marker >= 0xd0 && marker <= 0xd3)
+        return get_int64() >= 0;
+    // Positive fixint or uint 8-64
+    return marker <= 0x7f || (marker >= 0xcc && marker <= 0xcf);
+}
+
+std::int64_t value::get_int64() const noexcept
+{
+    const auto marker = detail::marker_of(data_);
+    switch (marker)
+    {
+    case 0xd0:
+        return detail::load_big<std::int8_t>(data_ + 1);
+    case 0xd1:
+        return detail::load_big<std::int16_t>(data_ + 1);
+    case 0xd2:
+        return detail::load_big<std::int32_t>(data_ + 1);
+    case 0xd3:
+        return detail::load_big<std::int64_t>(data_ + 1);
+    default:
+        if (marker >= 0xe0)
+            return static_cast<std::int8_t>(marker);
+        if (marker <= 0x7f || (marker >= 0xcc && marker <= 0xcf))
+            return static_cast<std::int64_t>(get_uint64());
+        return 0;
+    }
+}
+
+std::uint64_t value::get_uint64() const noexcept
+{
+    const auto marker = detail::marker_of(data_);
+    switch (marker)
+    {
+    case 0xcc:
+        return detail::load_big<std::uint8_t>(data_ + 1);
+    case 0xcd:
+        return detail::load_big<std::uint16_t>(data_ + 1);
+    case 0xce:
+        return detail::load_big<std::uint32_t>(data_ + 1);
+    case 0xcf:
+        return detail::load_big<std::uint64_t>(data_ + 1);
+    default:
+        if (marker <= 0x7f)
+            return marker;
+        if (marker >= 0xe0 || (marker >= 0xd0 && marker <= 0xd3))
+            return static_cast<std::uint64_t>(get_int64());
+        return 0;
+    }
+}
+
+double value::get_double() const noexcept
+{
+    const auto marker = detail::marker_of(data_);
+    if (marker == 0xca)
+    {
+        float f;
+        const auto bits = detail::load_big<std::uint32_t>(data_ + 1);
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+    if (marker == 0xcb)
+    {
+        double d;
+        const auto bits = detail::load_big<std::uint64_t>(data_ + 1);
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+    if (is_int64())
+        return static_cast<double>(get_int64());
+    return static_cast<double>(get_uint64());
+}
+
+std::string_view value::get_string() const noexcept
+{
+    const auto h = detail::decode(data_);
+    return {reinterpret_cast<const char*>(data_ + h.header_size),
+            static_cast<std::size_t>(h.payload_size)};
+}
+
+gsl::span<const std::byte> value::get_binary() const noexcept
+{
+    const auto h = detail::decode(data_);
+    return {data_ + h.header_size, static_cast<std::size_t>(h.payload_size)};
+}
+
+std::size_t value::size() const noexcept
+{
+    const auto h = detail::decode(data_);
+    switch (h.type)
+    {
+    case msgpack::type::array:
+        return static_cast<std::size_t>(h.children);
+    case msgpack::type::map:
+        return static_cast<std::size_t>(h.children / 2);
+    case msgpack::type::string:
+    case msgpack::type::binary:
+        return static_cast<std::size_t>(h.payload_size);
+    default:
+        return 0;
+    }
+}
+
+msgpack::value value::at(std::size_t index) const noexcept
+{
+    if (!is_array() || index >= size())
+        return {};
+
+    const auto* child = detail::first_child(data_);
+    while (index--)
+        child = detail::skip(child);
+    return msgpack::value{child};
+}
+
+msgpack::value value::at(std::string_view key) const noexcept
+{
+    if (!is_map())
+        return {};
+
+    const auto* child = detail::first_child(data_);
+    for (std::size_t i = 0, n = size(); i < n; ++i)
+    {
+        const msgpack::value k{child};
+        child = detail::skip(child);
+        if (k.is_string() && k.get_string() == key)
+            return msgpack::value{child};
+        child = detail::skip(child);
+    }
+    return {};
+}
+
+bool value::has_field(std::string_view key) const noexcept
+{
+    if (!is_map())
+        return false;
+
+    bool found = false;
+    for_each_field([&](const msgpack::value& k, const msgpack::value&) {
+        found = found || (k.is_string() && k.get_string() == key);
+    });
+    return found;
+}
+
+msgpack::value parse(gsl::span<const std::byte> data)
+{
+    const auto* it = data.data();
+    const auto* end = it + data.size();
+
+    // Every value takes at least one byte so we can reject absurd counts
+    // before trying to read that many values
+    std::uint64_t pending = 1;
+    while (pending--)
+    {
+        const auto available = static_cast<std::size_t>(end - it);
+        detail::header h;
+        if (!detail::read_header(it, available, h))
+        {
+            if (available == 0 || available < h.header_size)
+                throw serialization::parse_error{"unexpected end of data"};
+            throw serialization::parse_error{"invalid type marker at offset " +
+                                             std::to_string(it - data.data())};
+        }
+        if (h.payload_size > available - h.header_size)
+            throw serialization::parse_error{"unexpected end of data"};
+        it += h.header_size + h.payload_size;
+
+        pending += h.children;
+        if (pending > static_cast<std::uint64_t>(end - it))
+            throw serialization::parse_error{"unexpected end of data"};
+    }
+
+    if (it != end)
+        throw serialization::parse_error{"unexpected data after the root value"};
+    return msgpack::value{data.data()};
+}
+
+void writer::add_value()
+{
+    if (!open_.empty())
+        ++open_.back().count;
+}
+
+void writer::nil()
+{
+    add_value();
+    buffer_.push_back(std::byte{0xc0});
+}
+
+void writer::boolean(bool b)
+{
+    add_value();
+    buffer_.push_back(std::byte{b ? std::uint8_t{0xc3} : std::uint8_t{0xc2}});
+}
+
+namespace {
+
+template <typename T>
+void put(std::vector<std::byte>& buffer, std::uint8_t marker, T v)
+{
+    const auto offset = buffer.size();
+    buffer.resize(offset + 1 + sizeof(T));
+    buffer[offset] = std::byte{marker};
+    detail::store_big(buffer.data() + offset + 1, v);
+}
+
+void put_length(std::vector<std::byte>& buffer, std::size_t length, std::uint8_t marker8,
+                std::uint8_t marker16, std::uint8_t marker32)
+{
+    if (length <= 0xff)
+        put(buffer, marker8, static_cast<std::uint8_t>(length));
+    else if (length <= 0xffff)
+        put(buffer, marker16, static_cast<std::uint16_t>(length));
+    else if (length <= 0xffffffff)
+        put(buffer, marker32, static_cast<std::uint32_t>(length));
+    else
+        throw std::length_error{"MessagePack strings and binaries are limited to 4 GiB"};
+}
+
+void put_bytes(std::vector<std::byte>& buffer, const void* data, std::size_t size)
+{
+    const auto offset = buffer.size();
+    buffer.resize(offset + size);
+    if (size)
+        std::memcpy(buffer.data() + offset, data, size);
+}
+} // namespace
+
+void writer::int64(std::int64_t i)
+{
+    if (i >= 0)
+        return uint64(static_cast<std::uint64_t>(i));
+
+    add_value();
+    if (i >= -32)
+        buffer_.push_back(static_cast<std::byte>(static_cast<std::int8_t>(i)));
+    else if (i >= (std::numeric_limits<std::int8_t>::min)())
+        put(buffer_, 0xd0, static_cast<std::int8_t>(i));
+    else if (i >= (std::numeric_limits<std::int16_t>::min)())
+        put(buffer_, 0xd1, static_cast<std::int16_t>(i));
+    else if (i >= (std::numeric_limits<std::int32_t>::min)())
+        put(buffer_, 0xd2, static_cast<std::int32_t>(i));
+    else
+        put(buffer_, 0xd3, i);
+}
+
+void writer::uint64(std::uint64_t u)
+{
+    add_value();
+    if (u <= 0x7f)
+        buffer_.push_back(static_cast<std::byte>(u));
+    else if (u <= 0xff)
+        put(buffer_, 0xcc, static_cast<std::uint8_t>(u));
+    else if (u <= 0xffff)
+        put(buffer_, 0xcd, static_cast<std::uint16_t>(u));
+    else if (u <= 0xffffffff)
+        put(buffer_, 0xce, static_cast<std::uint32_t>(u));
+    else
+        put(buffer_, 0xcf, u);
+}
+
+void writer::float32(float f)
+{
+    add_value();
+    std::uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    put(buffer_, 0xca, bits);
+}
+
+void writer::float64(double d)
+{
+    add_value();
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    put(buffer_, 0xcb, bits);
+}
+
+void writer::string(std::string_view str)
+{
+    if (str.size() <= 31)
+        buffer_.push_back(static_cast<std::byte>(0xa0 | str.size()));
+    else
+        put_length(buffer_, str.size(), 0xd9, 0xda, 0xdb);
+    add_value();
+    put_bytes(buffer_, str.data(), str.size());
+}
+
+void writer::binary(gsl::span<const std::byte> bin)
+{
+    put_length(buffer_, bin.size(), 0xc4, 0xc5, 0xc6);
+    add_value();
+    put_bytes(buffer_, bin.data(), bin.size());
+}
+
+void writer::encoded(const msgpack::value& v)
+{
+    add_value();
+    const auto bytes = v.encoded();
+    put_bytes(buffer_, bytes.data(), bytes.size());
+}
+
+// Containers start with a 5 byte placeholder. Once closed the real header is
+// written at its front and once the outermost container is closed all the
+// placeholders are squeezed out in one pass over the buffer.
+void writer::begin_array()
+{
+    begin_container();
+}
+
+void writer::end_array()
+{
+    end_container(0x90, 0xdc, 0xdd, false);
+}
+
+void writer::begin_map()
+{
+    begin_container();
+}
+
+void writer::end_map()
+{
+    end_container(0x80, 0xde, 0xdf, true);
+}
+
+void writer::begin_container()
+{
+    add_value();
+    open_.push_back({headers_.size(), 0});
+    headers_.push_back({buffer_.size(), 5});
+    buffer_.resize(buffer_.size() + 5);
+}
+
+void writer::end_container(std::uint8_t fix_marker, std::uint8_t marker16,
+                           std::uint8_t marker32, bool is_map)
+{
+    const auto c = open_.back();
+    const auto count = is_map ? c.count / 2 : c.count;
+    if (count > 0xffffffff)
+        throw std::length_error{"MessagePack arrays and maps are limited to 2^32-1 elements"};
+    open_.pop_back();
+
+    auto& h = headers_[c.header];
+    auto* dest = buffer_.data() + h.offset;
+    if (count <= 15)
+    {
+        dest[0] = static_cast<std::byte>(fix_marker | count);
+        h.size = 1;
+    }
+    else if (count <= 0xffff)
+    {
+        dest[0] = std::byte{marker16};
+        detail::store_big(dest + 1, static_cast<std::uint16_t>(count));
+        h.size = 3;
+    }
+    else
+    {
+        dest[0] = std::byte{marker32};
+        detail::store_big(dest + 1, static_cast<std::uint32_t>(count));
+        h.size = 5;
+    }
+
+    if (open_.empty())
+        compact_headers();
+}
+
+void writer::compact_headers() noexcept
+{
+    // Headers are kept in the order they appear in the buffer so everything
+    // in between can be moved back by the space saved so far.
+    auto* data = buffer_.data();
+    auto out = headers_.front().offset;
+    for (std::size_t i = 0; i < headers_.size(); ++i)
+    {
+        const auto& h = headers_[i];
+        const auto body = h.offset + 5;
+        const auto body_end = i + 1 < headers_.size() ? headers_[i + 1].offset : buffer_.size();
+        std::memmove(data + out, data + h.offset, h.size);
+        out += h.size;
+        std::memmove(data + out, data + body, body_end - body);
+        out += body_end - body;
+    }
+    buffer_.resize(out);
+    headers_.clear();
+}
+
+std::vector<std::byte> writer::release() noexcept
+{
+    open_.clear();
+    headers_.clear();
+    return std::move(buffer_);
+}
+
+void writer::clear() noexcept
+{
+    buffer_.clear();
+    open_.clear();
+    headers_.clear();
+}
+} // namespace kl::msgpack
@@ -1,6 +1,10 @@
 #include "kl/serialization_error.hpp"
 
+#include <boost/core/demangle.hpp>
+
 #include <iterator>
+#include <string>
+#include <utility>
 
 namespace kl::serialization {
 
@@ -13,4 +17,98 @@ void deserialize_error::add(const char* message)
 deserialize_error::~deserialize_error() noexcept = default;
 parse_error::~parse_error() noexcept = default;
 
+std::string deserialize_status::message() const
+{
+    if (!failed_)
+        return {};
+
+    std::string msg = owned_reason_.empty() ? reason_ : owned_reason_;
+    if (detail_)
+        msg.append(detail_);
+
+    for (const auto& crumb : path_)
+    {
+        msg.insert(end(msg), '\n');
+        switch (crumb.kind)
+        {
+        case crumb_kind::field:
+            msg.append("error when deserializing field ");
+            break;
+        case crumb_kind::extra_field:
+            msg.append("error when deserializing extra field ");
+            break;
+        case crumb_kind::element:
+            msg.append("error when deserializing element ");
+            msg.append(std::to_string(crumb.index));
+            continue;
+        case crumb_kind::type:
+            msg.append("error when deserializing type ");
+            msg.append(boost::core::demangle(crumb.type->name()));
+            continue;
+        }
+        msg.append(crumb.name ? crumb.name : crumb.owned_name.c_str());
+    }
+    return msg;
+}
+
+void deserialize_status::raise() const
+{
+    throw deserialize_error{message()};
+}
+
+void deserialize_status::clear() noexcept
+{
+    failed_ = false;
+    reason_ = "";
+    detail_ = nullptr;
+    owned_reason_.clear();
+    path_.clear();
+}
+
+void deserialize_status::fail(const char* reason, const char* detail) noexcept
+{
+    failed_ = true;
+    reason_ = reason;
+    detail_ = detail;
+    owned_reason_.clear();
+}
+
+void deserialize_status::fail(std::string reason)
+{
+    failed_ = true;
+    reason_ = "";
+    detail_ = nullptr;
+    owned_reason_ = std::move(reason);
+}
+
+void deserialize_status::add_field(const char* name)
+{
+    path_.push_back({crumb_kind::field, 0, name, nullptr, {}});
+}
+
+void deserialize_status::add_field(std::string name)
+{
+    path_.push_back({crumb_kind::field, 0, nullptr, nullptr, std::move(name)});
+}
+
+void deserialize_status::add_extra_field(const char* name)
+{
+    path_.push_back({crumb_kind::extra_field, 0, name, nullptr, {}});
+}
+
+void deserialize_status::add_extra_field(std::string name)
+{
+    path_.push_back({crumb_kind::extra_field, 0, nullptr, nullptr, std::move(name)});
+}
+
+void deserialize_status::add_element(std::size_t index)
+{
+    path_.push_back({crumb_kind::element, index, nullptr, nullptr, {}});
+}
+
+void deserialize_status::add_type(const std::type_info& type)
+{
+    path_.push_back({crumb_kind::type, 0, nullptr, &type, {}});
+}
+
 } // namespace kl::serialization
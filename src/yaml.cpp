@@ -3,6 +3,7 @@
 #include "kl/enum_reflector.hpp"
 #include "kl/reflect_enum.hpp"
 
+#include <yaml-cpp/exceptions.h>
 #include <yaml-cpp/node/node.h>
 #include <yaml-cpp/node/type.h>
 
@@ -48,5 +49,48 @@ void expect_map(const YAML::Node& value)
     throw serialization::deserialize_error{"type must be a map but is a " +
                                            type_name(value)};
 }
+
+namespace {
+
+bool fail_type_check(const char* reason, const YAML::Node& value,
+                     serialization::deserialize_status& status)
+{
+    status.fail(reason, kl::to_string(value.Type()));
+    return false;
+}
+} // namespace
+
+bool check_scalar(const YAML::Node& value, serialization::deserialize_status& status)
+{
+    return value.IsScalar() ||
+           fail_type_check("type must be a scalar but is a ", value, status);
+}
+
+bool check_sequence(const YAML::Node& value, serialization::deserialize_status& status)
+{
+    return value.IsSequence() ||
+           fail_type_check("type must be a sequence but is a ", value, status);
+}
+
+bool check_map(const YAML::Node& value, serialization::deserialize_status& status)
+{
+    return value.IsMap() || fail_type_check("type must be a map but is a ", value, status);
+}
+
+bool fail_bad_conversion(const YAML::Node& value, serialization::deserialize_status& status)
+{
+    // Mirror YAML::Exception's what() so both paths report the same message
+    const auto mark = value.Mark();
+    if (mark.is_null())
+    {
+        status.fail(YAML::ErrorMsg::BAD_CONVERSION);
+    }
+    else
+    {
+        status.fail("yaml-cpp: error at line " + std::to_string(mark.line + 1) + ", column " +
+                    std::to_string(mark.column + 1) + ": " + YAML::ErrorMsg::BAD_CONVERSION);
+    }
+    return false;
+}
 } // namespace detail
 } // namespace kl::yaml
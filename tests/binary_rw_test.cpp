@@ -1,11 +1,19 @@
 #include "kl/binary_rw.hpp"
+#include "kl/binary_rw/delta.hpp"
 #include "kl/binary_rw/endian.hpp"
+#include "kl/binary_rw/frame.hpp"
 #include "kl/binary_rw/map.hpp"
 #include "kl/binary_rw/optional.hpp"
+#include "kl/binary_rw/pair.hpp"
+#include "kl/binary_rw/reflectable.hpp"
 #include "kl/binary_rw/set.hpp"
+#include "kl/binary_rw/stream_reader.hpp"
 #include "kl/binary_rw/string.hpp"
 #include "kl/binary_rw/variant.hpp"
+#include "kl/binary_rw/varint.hpp"
 #include "kl/binary_rw/vector.hpp"
+#include "kl/reflect_struct.hpp"
+#include "kl/serialization_attributes.hpp"
 
 #include <boost/endian/arithmetic.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -13,16 +21,27 @@
 #include <gsl/span>
 #include <gsl/span_ext> // operator==
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 static constexpr inline std::byte operator""_b(unsigned long long i)
 {
     return static_cast<std::byte>(i);
@@ -321,6 +340,43 @@ TEST_CASE("binary_reader - variant")
         REQUIRE(std::get<std::string>(ret) == "Hello, world!      ");
         REQUIRE(r.empty());
     }
+
+    SECTION("same type alternatives")
+    {
+        using same_variant = std::variant<std::int32_t, std::string, std::int32_t>;
+
+        growable_binary_writer w;
+        w << same_variant{std::in_place_index<2>, 7} << same_variant{std::in_place_index<0>, 8};
+
+        binary_reader r{w.bytes()};
+        const auto a = r.read<same_variant>();
+        const auto b = r.read<same_variant>();
+        REQUIRE(!r.err());
+        REQUIRE(a.index() == 2);
+        REQUIRE(std::get<2>(a) == 7);
+        REQUIRE(b.index() == 0);
+        REQUIRE(std::get<0>(b) == 8);
+    }
+
+    SECTION("read many")
+    {
+        growable_binary_writer w;
+        w << variant{std::string{"a"}} << variant{boost::endian::little_int32_t{5}}
+          << variant{std::string{"b"}};
+
+        std::array<variant, 3> vars;
+        binary_reader r{w.bytes()};
+        REQUIRE(read_variants(r, gsl::span<variant>{vars}));
+        REQUIRE(r.empty());
+        REQUIRE(std::get<std::string>(vars[0]) == "a");
+        REQUIRE(std::get<boost::endian::little_int32_t>(vars[1]) == 5);
+        REQUIRE(std::get<std::string>(vars[2]) == "b");
+
+        std::array<variant, 4> too_many;
+        binary_reader r2{w.bytes()};
+        REQUIRE(!read_variants(r2, gsl::span<variant>{too_many}));
+        REQUIRE(r2.err());
+    }
 }
 
 TEST_CASE("binary_reader - vector")
@@ -515,6 +571,21 @@ TEST_CASE("binary_writer - string")
         REQUIRE("Test" == r.read<std::string>());
         REQUIRE(r.left() == 1);
     }
+
+    SECTION("write string literal")
+    {
+        growable_binary_writer w;
+        const char* ptr = "ptr";
+        w << "Test" << ptr;
+        REQUIRE(!w.err());
+        REQUIRE(binary_size("Test") == 8);
+        REQUIRE(binary_size(ptr) == 7);
+
+        binary_reader r{w.bytes()};
+        REQUIRE("Test" == r.read<std::string>());
+        REQUIRE("ptr" == r.read<std::string>());
+        REQUIRE(r.empty());
+    }
 }
 
 TEST_CASE("binary_writer - map")
@@ -768,6 +839,82 @@ TEST_CASE("binary_writer - vector")
     }
 }
 
+TEST_CASE("binary_writer - growable")
+{
+    using namespace kl;
+
+    SECTION("empty")
+    {
+        growable_binary_writer w;
+        REQUIRE(w.bytes().empty());
+        REQUIRE(w.left() == 0);
+        REQUIRE(!w.err());
+    }
+
+    SECTION("grows as needed")
+    {
+        growable_binary_writer w;
+        w << std::string{"test"} << std::uint8_t{1};
+        REQUIRE(!w.err());
+        REQUIRE(w.pos() == 4 + 4 + 1);
+
+        const auto expected = std::array{4_b, 0_b, 0_b, 0_b, 't'_b, 'e'_b, 's'_b, 't'_b, 1_b};
+        REQUIRE(w.bytes() == gsl::span<const std::byte>{expected});
+
+        const std::vector<std::uint32_t> vec(1000, 0xdeadbeef);
+        w << vec;
+        REQUIRE(!w.err());
+        REQUIRE(w.pos() == 9 + 4 + 4000);
+
+        binary_reader r{w.bytes()};
+        REQUIRE(r.read<std::string>() == "test");
+        REQUIRE(r.read<std::uint8_t>() == 1);
+        REQUIRE(r.read<std::vector<std::uint32_t>>() == vec);
+        REQUIRE(r.empty());
+    }
+
+    SECTION("release")
+    {
+        growable_binary_writer w{16};
+        REQUIRE(w.left() == 16);
+        w << std::uint16_t{0x0102};
+
+        const auto bytes = w.release();
+        REQUIRE(bytes == std::vector{2_b, 1_b});
+        REQUIRE(w.pos() == 0);
+        REQUIRE(w.bytes().empty());
+
+        w << std::uint8_t{3};
+        REQUIRE(w.bytes().size() == 1);
+    }
+
+    SECTION("clear keeps capacity")
+    {
+        growable_binary_writer w;
+        w << std::uint64_t{1};
+        const auto capacity = w.pos() + w.left();
+        w.clear();
+        REQUIRE(w.pos() == 0);
+        REQUIRE(w.left() == capacity);
+    }
+
+    SECTION("arena")
+    {
+        std::array<std::byte, 1024> arena;
+        std::pmr::monotonic_buffer_resource resource{arena.data(), arena.size(),
+                                                     std::pmr::null_memory_resource()};
+        pmr_binary_writer w{0, &resource};
+        w << std::string(100, 'x');
+        REQUIRE(!w.err());
+        REQUIRE(w.bytes().data() >= arena.data());
+        REQUIRE(w.bytes().data() < arena.data() + arena.size());
+
+        // Arena exhausted
+        w << std::string(1000, 'x');
+        REQUIRE(w.err());
+    }
+}
+
 struct user_defined_type
 {
     float vec[4];
@@ -821,3 +968,1327 @@ TEST_CASE("binary_reader/writer - user defined type")
     REQUIRE(v[1].i == 55);
     REQUIRE(v[1].f == 10000.0f);
 }
+
+struct reflected_point
+{
+    std::int16_t x;
+    std::int16_t y;
+};
+KL_REFLECT_STRUCT(reflected_point, x, y)
+
+struct reflected_shape
+{
+    std::string name;
+    std::vector<reflected_point> points;
+    std::optional<std::uint8_t> colour;
+    int cache = -1;
+};
+KL_REFLECT_STRUCT(reflected_shape,
+                  name,
+                  points,
+                  colour,
+                  (cache, kl::serialization::attributes::skip))
+
+TEST_CASE("binary_reader/writer - reflectable type")
+{
+    using namespace kl;
+
+    SECTION("write")
+    {
+        std::array<std::byte, 4> buf{};
+        binary_writer w{buf};
+
+        w << reflected_point{1, -2};
+        REQUIRE(w.empty());
+        REQUIRE(!w.err());
+        REQUIRE(buf == std::array{1_b, 0_b, 0xfe_b, 0xff_b});
+    }
+
+    SECTION("round trip")
+    {
+        std::array<std::byte, 64> buf{};
+        binary_writer w{buf};
+
+        const reflected_shape shape{"tri", {{0, 0}, {3, 0}, {0, 4}}, 7, 13};
+        w << shape;
+        REQUIRE(!w.err());
+        // name + points + colour, skipped field isn't written
+        REQUIRE(w.pos() == (4 + 3) + (4 + 3 * 4) + (1 + 1));
+
+        binary_reader r{gsl::span<const std::byte>{buf}.first(w.pos())};
+        auto ret = r.read<reflected_shape>();
+        REQUIRE(r.empty());
+        REQUIRE(!r.err());
+        REQUIRE(ret.name == "tri");
+        REQUIRE(ret.points.size() == 3);
+        REQUIRE(ret.points[2].x == 0);
+        REQUIRE(ret.points[2].y == 4);
+        REQUIRE(ret.colour == 7);
+        REQUIRE(ret.cache == -1);
+    }
+
+    SECTION("buffer too short")
+    {
+        std::array<std::byte, 3> buf = {1_b, 0_b, 2_b};
+        binary_reader r{buf};
+
+        r.read<reflected_point>();
+        REQUIRE(r.err());
+    }
+}
+
+struct point3f
+{
+    float x, y, z;
+};
+KL_REFLECT_STRUCT(point3f, x, y, z)
+
+struct triangle
+{
+    point3f a, b, c;
+};
+KL_REFLECT_STRUCT(triangle, a, b, c)
+
+struct padded_point
+{
+    std::uint8_t tag;
+    std::uint32_t value;
+};
+KL_REFLECT_STRUCT(padded_point, tag, value)
+
+struct reordered_point
+{
+    float x, y;
+};
+KL_REFLECT_STRUCT(reordered_point, y, x)
+
+struct partially_reflected_point
+{
+    float x, y;
+};
+KL_REFLECT_STRUCT(partially_reflected_point, x)
+
+int next_item_id()
+{
+    static int id = 0;
+    return ++id;
+}
+
+// Default member initializer that can't be evaluated at compile time
+struct item
+{
+    int id = next_item_id();
+    float weight;
+    bool active;
+    std::uint8_t flags;
+    std::uint16_t count;
+};
+KL_REFLECT_STRUCT(item, id, weight, active, flags, count)
+
+TEST_CASE("binary_reader/writer - trivial binary layout")
+{
+    using namespace kl;
+
+    static_assert(has_trivial_binary_layout_v<int>);
+    static_assert(has_trivial_binary_layout_v<reflected_point>);
+    static_assert(has_trivial_binary_layout_v<point3f>);
+    static_assert(has_trivial_binary_layout_v<triangle>);
+    static_assert(!has_trivial_binary_layout_v<padded_point>);
+    static_assert(!has_trivial_binary_layout_v<reordered_point>);
+    static_assert(!has_trivial_binary_layout_v<partially_reflected_point>);
+    static_assert(!has_trivial_binary_layout_v<reflected_shape>);
+    static_assert(has_trivial_binary_layout_v<item>);
+
+    SECTION("same bytes as field by field")
+    {
+        const std::vector<triangle> tris = {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
+                                            {{-1, -2, -3}, {0, 0, 0}, {0.5f, 0.25f, 1}}};
+
+        growable_binary_writer bulk;
+        bulk << tris;
+
+        growable_binary_writer one_by_one;
+        one_by_one << static_cast<std::uint32_t>(tris.size());
+        for (const auto& tri : tris)
+            one_by_one << tri.a.x << tri.a.y << tri.a.z << tri.b.x << tri.b.y << tri.b.z
+                       << tri.c.x << tri.c.y << tri.c.z;
+
+        REQUIRE(bulk.bytes() == one_by_one.bytes());
+        REQUIRE(binary_size(tris) == bulk.pos());
+
+        binary_reader r{bulk.bytes()};
+        const auto ret = r.read<std::vector<triangle>>();
+        REQUIRE(!r.err());
+        REQUIRE(r.empty());
+        REQUIRE(ret.size() == 2);
+        REQUIRE(ret[1].c.x == 0.5f);
+        REQUIRE(ret[1].c.y == 0.25f);
+        REQUIRE(ret[1].a.z == -3);
+    }
+
+    SECTION("non-constexpr member initializer")
+    {
+        std::vector<item> items(2);
+        items[1].weight = 0.5f;
+        items[1].active = true;
+        items[1].count = 300;
+
+        growable_binary_writer w;
+        w << items;
+        REQUIRE(w.pos() == 4 + 2 * sizeof(item));
+
+        binary_reader r{w.bytes()};
+        const auto ret = r.read<std::vector<item>>();
+        REQUIRE(!r.err());
+        REQUIRE(ret.size() == 2);
+        REQUIRE(ret[1].id == items[1].id);
+        REQUIRE(ret[1].weight == 0.5f);
+        REQUIRE(ret[1].active);
+        REQUIRE(ret[1].count == 300);
+    }
+
+    SECTION("borrowed")
+    {
+        growable_binary_writer w;
+        w << std::vector<point3f>{{1, 2, 3}, {4, 5, 6}};
+        const auto bytes = w.release();
+
+        binary_reader r{bytes};
+        gsl::span<const point3f> points;
+        REQUIRE(read_borrowed(r, points));
+        REQUIRE(points.size() == 2);
+        REQUIRE(points[1].y == 5);
+    }
+
+    SECTION("not trivial layout")
+    {
+        growable_binary_writer w;
+        w << std::vector<padded_point>{{1, 2}, {3, 4}}
+          << std::vector<reordered_point>{{1, 2}};
+        // No padding written and fields go in reflection order
+        REQUIRE(w.pos() == (4 + 2 * 5) + (4 + 2 * 4));
+
+        binary_reader r{w.bytes()};
+        const auto padded = r.read<std::vector<padded_point>>();
+        const auto reordered = r.read<std::vector<reordered_point>>();
+        REQUIRE(!r.err());
+        REQUIRE(padded.size() == 2);
+        REQUIRE(padded[1].tag == 3);
+        REQUIRE(padded[1].value == 4);
+        REQUIRE(reordered.size() == 1);
+        REQUIRE(reordered[0].x == 1);
+        REQUIRE(reordered[0].y == 2);
+    }
+}
+
+// Reflected (e.g. for JSON) but with a binary format of its own
+struct custom_format_sample
+{
+    std::uint32_t a;
+    std::uint32_t b;
+};
+KL_REFLECT_STRUCT(custom_format_sample, a, b)
+
+void write_binary(kl::binary_writer& w, const custom_format_sample& value)
+{
+    w << boost::endian::big_uint32_t{value.a} << boost::endian::big_uint32_t{value.b};
+}
+
+void read_binary(kl::binary_reader& r, custom_format_sample& value)
+{
+    value.a = r.read<boost::endian::big_uint32_t>();
+    value.b = r.read<boost::endian::big_uint32_t>();
+}
+
+std::size_t binary_size(kl::binary_size_tag, const custom_format_sample&)
+{
+    return 2 * sizeof(std::uint32_t);
+}
+
+TEST_CASE("binary_reader/writer - reflectable type with own format")
+{
+    using namespace kl;
+
+    static_assert(fixed_binary_size_v<custom_format_sample> == 0);
+    static_assert(!has_trivial_binary_layout_v<custom_format_sample>);
+    static_assert(!is_unchecked_readable_v<custom_format_sample>);
+    static_assert(!is_unchecked_readable_v<std::pair<custom_format_sample, std::uint8_t>>);
+
+    const custom_format_sample sample{1, 2};
+    growable_binary_writer single;
+    single << sample;
+    REQUIRE(single.bytes()[0] == 0_b);
+
+    SECTION("pair")
+    {
+        const std::pair<custom_format_sample, std::uint8_t> pair{sample, 1};
+        growable_binary_writer w;
+        w << pair;
+        REQUIRE(binary_size(pair) == w.pos());
+
+        binary_reader r{w.bytes()};
+        const auto ret = r.read<std::pair<custom_format_sample, std::uint8_t>>();
+        REQUIRE(!r.err());
+        REQUIRE(r.empty());
+        REQUIRE(ret.first.a == 1);
+        REQUIRE(ret.first.b == 2);
+        REQUIRE(ret.second == 1);
+    }
+
+    SECTION("binary_size")
+    {
+        const std::vector<custom_format_sample> samples{sample, sample};
+        growable_binary_writer w;
+        w << samples;
+        REQUIRE(binary_size(sample) == single.pos());
+        REQUIRE(binary_size(samples) == w.pos());
+    }
+
+    SECTION("vector")
+    {
+        const std::vector<custom_format_sample> samples{sample, sample};
+        growable_binary_writer w;
+        w << samples;
+        REQUIRE(binary_size(samples) == w.pos());
+        REQUIRE(std::equal(single.bytes().begin(), single.bytes().end(), w.bytes().begin() + 4));
+
+        binary_reader r{w.bytes()};
+        const auto ret = r.read<std::vector<custom_format_sample>>();
+        REQUIRE(!r.err());
+        REQUIRE(ret.size() == 2);
+        REQUIRE(ret[1].a == 1);
+        REQUIRE(ret[1].b == 2);
+    }
+}
+
+TEST_CASE("binary_reader - unchecked")
+{
+    using namespace kl;
+
+    static_assert(is_unchecked_readable_v<std::uint32_t>);
+    static_assert(is_unchecked_readable_v<boost::endian::big_uint16_t>);
+    static_assert(is_unchecked_readable_v<std::pair<std::uint8_t, boost::endian::big_int32_t>>);
+    static_assert(is_unchecked_readable_v<padded_point>);
+    static_assert(is_unchecked_readable_v<triangle>);
+    static_assert(!is_unchecked_readable_v<std::string>);
+    static_assert(!is_unchecked_readable_v<std::pair<int, std::string>>);
+    static_assert(!is_unchecked_readable_v<reflected_shape>);
+
+    std::array<std::byte, 7> buf = {1_b, 2_b, 0_b, 0_b, 0_b, 0xab_b, 0xcd_b};
+
+    SECTION("cursor")
+    {
+        binary_reader r{buf};
+        REQUIRE(r.ensure(7));
+        REQUIRE(r.pos() == 0);
+
+        auto u = r.unchecked(5);
+        REQUIRE(u);
+        REQUIRE(r.pos() == 5);
+
+        std::uint8_t a;
+        std::uint32_t b;
+        u >> a >> b;
+        REQUIRE(a == 1);
+        REQUIRE(b == 2);
+        REQUIRE(u.left() == 0);
+
+        REQUIRE(!r.unchecked(3));
+        REQUIRE(r.err());
+        REQUIRE(!r.ensure(1));
+    }
+
+    SECTION("composite types")
+    {
+        binary_reader r{buf};
+        const auto pt = r.read<padded_point>();
+        const auto pair = r.read<std::pair<std::uint8_t, std::uint8_t>>();
+        REQUIRE(!r.err());
+        REQUIRE(r.empty());
+        REQUIRE(pt.tag == 1);
+        REQUIRE(pt.value == 2);
+        REQUIRE(pair.first == 0xab);
+        REQUIRE(pair.second == 0xcd);
+    }
+
+    SECTION("buffer too short")
+    {
+        binary_reader r{gsl::span<const std::byte>{buf}.first(4)};
+        padded_point pt{7, 7};
+        r >> pt;
+        REQUIRE(r.err());
+        // Nothing is read then
+        REQUIRE(pt.tag == 7);
+        REQUIRE(pt.value == 7);
+    }
+}
+
+TEST_CASE("binary_size")
+{
+    using namespace kl;
+
+    // Must match what's actually written
+    auto written_size = [](const auto& value) {
+        growable_binary_writer w;
+        w << value;
+        REQUIRE(!w.err());
+        return w.pos();
+    };
+
+    SECTION("fixed size types")
+    {
+        static_assert(binary_size<std::uint8_t>() == 1);
+        static_assert(binary_size<double>() == 8);
+        static_assert(binary_size<boost::endian::little_uint24_t>() == 3);
+        static_assert(binary_size<std::pair<int, std::uint16_t>>() == 6);
+        static_assert(binary_size<reflected_point>() == 4);
+        static_assert(fixed_binary_size_v<std::string> == 0);
+        static_assert(fixed_binary_size_v<reflected_shape> == 0);
+
+        REQUIRE(binary_size(std::int64_t{1}) == 8);
+        REQUIRE(binary_size(reflected_point{1, 2}) == written_size(reflected_point{1, 2}));
+    }
+
+    SECTION("containers")
+    {
+        const std::string str = "qwerty";
+        REQUIRE(binary_size(str) == written_size(str));
+        REQUIRE(binary_size(std::string{}) == 4);
+
+        const std::vector<int> ints(10, 1);
+        REQUIRE(binary_size(ints) == written_size(ints));
+        const std::vector<std::string> strs = {"a", "bc", ""};
+        REQUIRE(binary_size(strs) == written_size(strs));
+
+        const std::map<std::string, int> map = {{"one", 1}, {"two", 2}};
+        REQUIRE(binary_size(map) == written_size(map));
+        const std::map<int, boost::endian::big_uint16_t> fixed_map = {{1, 1}, {2, 2}};
+        REQUIRE(binary_size(fixed_map) == written_size(fixed_map));
+
+        const std::set<std::string> set = {"x", "yz"};
+        REQUIRE(binary_size(set) == written_size(set));
+
+        const auto pair = std::make_pair(std::string{"key"}, 3);
+        REQUIRE(binary_size(pair) == written_size(pair));
+
+        const std::optional<std::string> opt = "opt";
+        REQUIRE(binary_size(opt) == written_size(opt));
+        REQUIRE(binary_size(std::optional<int>{}) == 1);
+
+        const std::variant<int, std::string> var = "variant";
+        REQUIRE(binary_size(var) == written_size(var));
+    }
+
+    SECTION("reflectable")
+    {
+        const reflected_shape shape{"tri", {{0, 0}, {3, 0}, {0, 4}}, 7, 13};
+        REQUIRE(binary_size(shape) == written_size(shape));
+    }
+
+    SECTION("write into exactly sized buffer")
+    {
+        const reflected_shape shape{"square", {{0, 0}, {1, 0}, {1, 1}, {0, 1}}, {}, 0};
+        std::vector<std::byte> buf(binary_size(shape));
+        binary_writer w{buf};
+        w << shape;
+        REQUIRE(!w.err());
+        REQUIRE(w.empty());
+    }
+}
+
+TEST_CASE("binary_reader/writer - varint")
+{
+    using namespace kl;
+
+    auto encode = [](std::uint64_t value) {
+        growable_binary_writer w;
+        w.write_varint(value);
+        return w.release();
+    };
+
+    SECTION("encoding")
+    {
+        REQUIRE(encode(0) == std::vector{0_b});
+        REQUIRE(encode(127) == std::vector{0x7f_b});
+        REQUIRE(encode(128) == std::vector{0x80_b, 0x01_b});
+        REQUIRE(encode(300) == std::vector{0xac_b, 0x02_b});
+        REQUIRE(encode(std::numeric_limits<std::uint64_t>::max()).size() == 10);
+        REQUIRE(varint_binary_size(300) == 2);
+        REQUIRE(varint_binary_size(std::numeric_limits<std::uint64_t>::max()) == 10);
+    }
+
+    SECTION("round trip")
+    {
+        const std::uint64_t values[] = {0,
+                                        1,
+                                        127,
+                                        128,
+                                        16383,
+                                        16384,
+                                        (1ULL << 56) - 1,
+                                        1ULL << 56,
+                                        (1ULL << 63) - 1,
+                                        std::numeric_limits<std::uint64_t>::max()};
+
+        for (const auto value : values)
+        {
+            auto bytes = encode(value);
+
+            // Exact buffer goes through byte by byte decoding, padded one
+            // (mostly) through the 8-byte fast path
+            for (const auto padding : {0, 8})
+            {
+                bytes.resize(varint_binary_size(value) + padding);
+                binary_reader r{bytes};
+                std::uint64_t decoded = 0;
+                REQUIRE(r.read_varint(decoded));
+                REQUIRE(decoded == value);
+                REQUIRE(r.pos() == varint_binary_size(value));
+            }
+        }
+    }
+
+    SECTION("truncated")
+    {
+        std::array<std::byte, 2> buf = {0x80_b, 0x80_b};
+        binary_reader r{buf};
+        std::uint64_t value;
+        REQUIRE(!r.read_varint(value));
+        REQUIRE(r.err());
+    }
+
+    SECTION("too long")
+    {
+        std::array<std::byte, 11> buf;
+        buf.fill(0xff_b);
+        buf[10] = 0x01_b;
+        binary_reader r{buf};
+        std::uint64_t value;
+        REQUIRE(!r.read_varint(value));
+        REQUIRE(r.err());
+    }
+
+    SECTION("zig-zag")
+    {
+        REQUIRE(zigzag_encode(0) == 0);
+        REQUIRE(zigzag_encode(-1) == 1);
+        REQUIRE(zigzag_encode(1) == 2);
+        REQUIRE(zigzag_encode(-2) == 3);
+        REQUIRE(zigzag_decode(zigzag_encode(std::numeric_limits<std::int64_t>::min())) ==
+                std::numeric_limits<std::int64_t>::min());
+        REQUIRE(zigzag_decode(zigzag_encode(std::numeric_limits<std::int64_t>::max())) ==
+                std::numeric_limits<std::int64_t>::max());
+
+        growable_binary_writer w;
+        w << varint<int>{-3} << varint<std::int64_t>{-1000000} << varint<std::uint16_t>{65535};
+        REQUIRE(w.pos() == 1 + 3 + 3);
+
+        binary_reader r{w.bytes()};
+        REQUIRE(r.read<varint<int>>() == -3);
+        REQUIRE(r.read<varint<std::int64_t>>() == -1000000);
+        REQUIRE(r.read<varint<std::uint16_t>>() == 65535);
+        REQUIRE(r.empty());
+        REQUIRE(!r.err());
+    }
+
+    SECTION("value out of range")
+    {
+        const auto bytes = encode(300);
+        binary_reader r{bytes};
+        r.read<varint<std::uint8_t>>();
+        REQUIRE(r.err());
+    }
+
+    SECTION("compact lengths")
+    {
+        const std::vector<std::string> strs = {"a", "bc"};
+        const std::map<int, std::string> map = {{1, "x"}};
+
+        growable_binary_writer w;
+        w.set_encoding(binary_encoding::compact);
+        w << strs << map;
+        REQUIRE(!w.err());
+        REQUIRE(w.pos() == (1 + 2 + 3) + (1 + 4 + 2));
+        REQUIRE(binary_size(strs, binary_encoding::compact) +
+                    binary_size(map, binary_encoding::compact) ==
+                w.pos());
+
+        binary_reader r{w.bytes()};
+        r.set_encoding(binary_encoding::compact);
+        REQUIRE(r.read<std::vector<std::string>>() == strs);
+        REQUIRE(r.read<std::map<int, std::string>>() == map);
+        REQUIRE(r.empty());
+        REQUIRE(!r.err());
+    }
+
+    SECTION("compact length too big")
+    {
+        const auto bytes = encode(1ULL << 32);
+        binary_reader r{bytes};
+        r.set_encoding(binary_encoding::compact);
+        r.read<std::string>();
+        REQUIRE(r.err());
+    }
+}
+
+TEST_CASE("binary_reader - borrowed views")
+{
+    using namespace kl;
+
+    SECTION("string_view")
+    {
+        growable_binary_writer w;
+        w << std::string{"hello"} << std::string_view{"world"} << std::string_view{};
+        const auto bytes = w.release();
+
+        binary_reader r{bytes};
+        std::string_view a, b, c{"x"};
+        r >> a >> b >> c;
+        REQUIRE(!r.err());
+        REQUIRE(r.empty());
+        REQUIRE(a == "hello");
+        REQUIRE(b == "world");
+        REQUIRE(c.empty());
+        // Points directly into the buffer
+        REQUIRE(reinterpret_cast<const std::byte*>(a.data()) == bytes.data() + 4);
+        REQUIRE(binary_size(std::string_view{"world"}) == 9);
+    }
+
+    SECTION("string_view - compact")
+    {
+        growable_binary_writer w;
+        w.set_encoding(binary_encoding::compact);
+        w << std::string_view{"abc"};
+        const auto bytes = w.release();
+        REQUIRE(bytes.size() == 4);
+
+        binary_reader r{bytes};
+        r.set_encoding(binary_encoding::compact);
+        REQUIRE(r.read<std::string_view>() == "abc");
+        REQUIRE(!r.err());
+    }
+
+    SECTION("string_view - truncated")
+    {
+        growable_binary_writer w;
+        w << std::string{"hello"};
+        auto bytes = w.release();
+        bytes.pop_back();
+
+        binary_reader r{bytes};
+        std::string_view str{"x"};
+        r >> str;
+        REQUIRE(r.err());
+        REQUIRE(str.empty());
+    }
+
+    SECTION("span")
+    {
+        growable_binary_writer w;
+        w << std::vector<std::uint32_t>{1, 2, 3} << std::vector<std::uint32_t>{};
+        const auto bytes = w.release();
+
+        binary_reader r{bytes};
+        gsl::span<const std::uint32_t> a, b;
+        REQUIRE(read_borrowed(r, a));
+        REQUIRE(read_borrowed(r, b));
+        REQUIRE(r.empty());
+        REQUIRE(a.size() == 3);
+        REQUIRE(a[0] == 1);
+        REQUIRE(a[2] == 3);
+        REQUIRE(reinterpret_cast<const std::byte*>(a.data()) == bytes.data() + 4);
+        REQUIRE(b.empty());
+    }
+
+    SECTION("span - misaligned")
+    {
+        growable_binary_writer w;
+        w << std::uint8_t{0} << std::vector<std::uint32_t>{1, 2};
+        const auto bytes = w.release();
+
+        binary_reader r{bytes};
+        r.skip(1);
+        gsl::span<const std::uint32_t> span;
+        REQUIRE(!read_borrowed(r, span));
+        REQUIRE(r.err());
+        REQUIRE(span.empty());
+    }
+
+    SECTION("span - truncated")
+    {
+        alignas(8) std::array<std::byte, 8> buf = {0xff_b, 0xff_b, 0xff_b, 0x0f_b};
+        binary_reader r{buf};
+        gsl::span<const std::uint32_t> span;
+        REQUIRE(!read_borrowed(r, span));
+        REQUIRE(r.err());
+        REQUIRE(span.empty());
+    }
+}
+
+TEST_CASE("binary_reader/writer - endian span")
+{
+    using namespace kl;
+    using boost::endian::order;
+
+    // Sizes around SIMD block boundaries so both bulk and tail paths are taken
+    const std::size_t counts[] = {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100};
+
+    SECTION("matches endian_arithmetic")
+    {
+        for (const auto count : counts)
+        {
+            std::vector<std::uint16_t> u16(count);
+            std::vector<std::int32_t> i32(count);
+            std::vector<std::uint64_t> u64(count);
+            std::vector<double> f64(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                u16[i] = static_cast<std::uint16_t>(0x0102 + i * 0x0305);
+                i32[i] = static_cast<std::int32_t>(0x01020304 - i * 0x05060708);
+                u64[i] = 0x0102030405060708ULL * (i + 1);
+                f64[i] = 1.5 * static_cast<double>(i) - 7;
+            }
+
+            growable_binary_writer w;
+            REQUIRE(write_endian_span<order::big>(w, gsl::span{u16}));
+            REQUIRE(write_endian_span<order::big>(w, gsl::span{i32}));
+            REQUIRE(write_endian_span<order::little>(w, gsl::span{u64}));
+
+            growable_binary_writer ref;
+            for (const auto v : u16)
+                ref << boost::endian::big_uint16_t{v};
+            for (const auto v : i32)
+                ref << boost::endian::big_int32_t{v};
+            for (const auto v : u64)
+                ref << boost::endian::little_uint64_t{v};
+            REQUIRE(w.bytes() == ref.bytes());
+
+            write_endian_span<order::big>(w, gsl::span{f64});
+
+            binary_reader r{w.bytes()};
+            std::vector<std::uint16_t> u16_ret(count);
+            std::vector<std::int32_t> i32_ret(count);
+            std::vector<std::uint64_t> u64_ret(count);
+            std::vector<double> f64_ret(count);
+            REQUIRE(read_endian_span<order::big>(r, gsl::span{u16_ret}));
+            REQUIRE(read_endian_span<order::big>(r, gsl::span{i32_ret}));
+            REQUIRE(read_endian_span<order::little>(r, gsl::span{u64_ret}));
+            REQUIRE(read_endian_span<order::big>(r, gsl::span{f64_ret}));
+            REQUIRE(r.empty());
+            REQUIRE(u16_ret == u16);
+            REQUIRE(i32_ret == i32);
+            REQUIRE(u64_ret == u64);
+            REQUIRE(f64_ret == f64);
+        }
+    }
+
+    SECTION("endian_arithmetic spans")
+    {
+        std::vector<boost::endian::big_uint32_t> big(37);
+        for (std::size_t i = 0; i < big.size(); ++i)
+            big[i] = static_cast<std::uint32_t>(i * 0x01010101);
+
+        std::vector<std::uint32_t> host(big.size());
+        load_endian_span(gsl::span<const boost::endian::big_uint32_t>{big}, gsl::span{host});
+        for (std::size_t i = 0; i < big.size(); ++i)
+            REQUIRE(host[i] == big[i]);
+
+        std::vector<boost::endian::big_uint32_t> big_ret(big.size());
+        store_endian_span(gsl::span<const std::uint32_t>{host}, gsl::span{big_ret});
+        for (std::size_t i = 0; i < big.size(); ++i)
+            REQUIRE(big_ret[i] == big[i]);
+    }
+
+    SECTION("each kernel")
+    {
+        // reverse_bytes_copy() only runs the best kernel so check the others directly
+        const auto kernels = detail::reverse_bytes_kernels();
+        REQUIRE(!kernels.empty());
+
+        std::vector<std::byte> src(8 * 100 + 1);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<std::byte>(i * 37 + 11);
+
+        for (const auto kernel : kernels)
+        {
+            for (const std::size_t size : {2, 4, 8})
+            {
+                for (const auto count : counts)
+                {
+                    // Odd offset to also check unaligned loads and stores
+                    std::vector<std::byte> dst(count * size + 1);
+                    kernel(dst.data() + 1, src.data() + 1, count, size);
+                    for (std::size_t i = 0; i < count * size; ++i)
+                        REQUIRE(dst[1 + i] == src[1 + i / size * size + (size - 1 - i % size)]);
+
+                    // In place
+                    auto copy = src;
+                    kernel(copy.data() + 1, copy.data() + 1, count, size);
+                    REQUIRE(gsl::span{copy}.subspan(1, count * size) ==
+                            gsl::span{dst}.subspan(1));
+                }
+            }
+        }
+    }
+
+    SECTION("buffer too short")
+    {
+        std::array<std::byte, 7> buf{};
+        binary_reader r{buf};
+        std::array<std::uint32_t, 2> values{};
+        REQUIRE(!read_endian_span<order::big>(r, gsl::span{values}));
+        REQUIRE(r.err());
+
+        binary_writer w{buf};
+        REQUIRE(!write_endian_span<order::big>(w, gsl::span{values}));
+        REQUIRE(w.err());
+        REQUIRE(w.pos() == 0);
+    }
+}
+
+TEST_CASE("stream_binary_reader")
+{
+    using namespace kl;
+
+    growable_binary_writer w;
+    w << std::uint32_t{0x01020304} << std::string{"stream"}
+      << std::vector<std::uint16_t>(300, 0xabcd) << reflected_point{-1, 2};
+    w.write_varint(1ULL << 40);
+    const auto bytes = w.release();
+
+    // Returns at most 7 bytes at a time like a slow pipe would
+    auto make_source = [&bytes](std::size_t& offset) {
+        return [&bytes, &offset](gsl::span<std::byte> buffer) -> std::ptrdiff_t {
+            const auto n = (std::min)({buffer.size(), bytes.size() - offset, std::size_t{7}});
+            std::copy_n(bytes.data() + offset, n, buffer.data());
+            offset += n;
+            return static_cast<std::ptrdiff_t>(n);
+        };
+    };
+
+    auto check = [](stream_binary_reader& r) {
+        REQUIRE(r.read<std::uint32_t>() == 0x01020304);
+        REQUIRE(r.read<std::string>() == "stream");
+        // Bigger than the buffer
+        const auto vec = r.read<std::vector<std::uint16_t>>();
+        REQUIRE(vec == std::vector<std::uint16_t>(300, 0xabcd));
+        const auto pt = r.read<reflected_point>();
+        REQUIRE(pt.x == -1);
+        REQUIRE(pt.y == 2);
+        std::uint64_t varint = 0;
+        REQUIRE(r.read_varint(varint));
+        REQUIRE(varint == 1ULL << 40);
+        REQUIRE(!r.err());
+        REQUIRE(r.at_end());
+    };
+
+    SECTION("callback source")
+    {
+        std::size_t offset = 0;
+        stream_binary_reader r{make_source(offset), 64};
+        check(r);
+        REQUIRE(r.offset() == bytes.size());
+
+        r.read<std::uint8_t>();
+        REQUIRE(r.err());
+    }
+
+    SECTION("skip")
+    {
+        std::size_t offset = 0;
+        stream_binary_reader r{make_source(offset), 64};
+        r.skip(4 + 4 + 6 + 4 + 300 * 2);
+        REQUIRE(r.read<reflected_point>().x == -1);
+        REQUIRE(!r.err());
+
+        r.skip(100);
+        REQUIRE(r.err());
+    }
+
+    SECTION("source error")
+    {
+        stream_binary_reader r{[](gsl::span<std::byte>) -> std::ptrdiff_t { return -1; }};
+        r.read<std::uint8_t>();
+        REQUIRE(r.err());
+    }
+
+    SECTION("throwing source")
+    {
+        stream_binary_reader r{[](gsl::span<std::byte>) -> std::ptrdiff_t {
+            throw std::runtime_error{"connection reset"};
+        }};
+        r.read<std::uint8_t>();
+        REQUIRE(r.err());
+        REQUIRE(r.at_end());
+    }
+
+    SECTION("borrowed reads bigger than the buffer")
+    {
+        growable_binary_writer big;
+        big << std::string(100, 'x') << std::string(100, 'y');
+        const auto data = big.release();
+
+        std::size_t offset = 0;
+        stream_binary_reader r{[&](gsl::span<std::byte> buffer) -> std::ptrdiff_t {
+                                   const auto n = (std::min)(buffer.size(), data.size() - offset);
+                                   std::copy_n(data.data() + offset, n, buffer.data());
+                                   offset += n;
+                                   return static_cast<std::ptrdiff_t>(n);
+                               },
+                               64};
+
+        // Copying read of the same data is fine
+        REQUIRE(r.read<std::string>() == std::string(100, 'x'));
+
+        std::string_view view;
+        r >> view;
+        REQUIRE(r.err());
+        REQUIRE(view.empty());
+
+        stream_binary_reader r2{[](gsl::span<std::byte> buffer) -> std::ptrdiff_t {
+                                    std::fill(buffer.begin(), buffer.end(), 0_b);
+                                    return static_cast<std::ptrdiff_t>(buffer.size());
+                                },
+                                64};
+        REQUIRE(r2.span(65).empty());
+        REQUIRE(r2.err());
+    }
+
+    SECTION("short messages on a live stream")
+    {
+        // Delivers one byte per call and, like an open socket, would block
+        // once everything sent so far has been consumed
+        growable_binary_writer msgs;
+        msgs.set_encoding(binary_encoding::compact);
+        msgs << std::string{"hi"} << std::uint8_t{7};
+        msgs.write_varint(300);
+        const auto data = msgs.release();
+
+        std::size_t offset = 0;
+        bool blocked = false;
+        stream_binary_reader r{[&](gsl::span<std::byte> buffer) -> std::ptrdiff_t {
+            if (offset == data.size())
+            {
+                blocked = true;
+                return -1;
+            }
+            buffer[0] = data[offset++];
+            return 1;
+        }};
+        r.set_encoding(binary_encoding::compact);
+
+        REQUIRE(r.read<std::string>() == "hi");
+        REQUIRE(r.read<std::uint8_t>() == 7);
+        std::uint64_t varint = 0;
+        REQUIRE(r.read_varint(varint));
+        REQUIRE(varint == 300);
+        REQUIRE(!blocked);
+        REQUIRE(!r.err());
+    }
+
+#if !defined(_WIN32)
+    SECTION("file descriptor")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        REQUIRE(::write(fds[1], bytes.data(), bytes.size()) ==
+                static_cast<::ssize_t>(bytes.size()));
+        ::close(fds[1]);
+
+        stream_binary_reader r{fds[0], 64};
+        check(r);
+        ::close(fds[0]);
+    }
+
+    SECTION("pipe kept open")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        const std::uint8_t msg[] = {2, 'h', 'i'};
+        REQUIRE(::write(fds[1], msg, sizeof(msg)) == static_cast<::ssize_t>(sizeof(msg)));
+
+        stream_binary_reader r{fds[0], 64};
+        r.set_encoding(binary_encoding::compact);
+        REQUIRE(r.read<std::string>() == "hi");
+        ::close(fds[1]);
+        ::close(fds[0]);
+    }
+#endif
+}
+
+TEST_CASE("gather_binary_writer")
+{
+    using namespace kl;
+
+    // Referenced data must outlive the writer's segments
+    const std::vector<std::byte> blob(1000, 0x5a_b);
+    const std::string text(300, 'x');
+    const std::vector<std::uint16_t> small(10, 3);
+    const std::vector<std::uint64_t> large(100, 7);
+
+    auto write_message = [&](binary_writer& w) {
+        w << std::uint32_t{1} << std::string{"small"};
+        w << std::uint32_t{static_cast<std::uint32_t>(blob.size())}
+          << gsl::span<const std::byte>{blob};
+        w << text << small << large;
+    };
+
+    growable_binary_writer expected;
+    write_message(expected);
+
+    auto concat = [](const std::vector<gsl::span<const std::byte>>& segments) {
+        std::vector<std::byte> ret;
+        for (const auto& segment : segments)
+            ret.insert(ret.end(), segment.begin(), segment.end());
+        return ret;
+    };
+
+    SECTION("segments")
+    {
+        gather_binary_writer w;
+        write_message(w);
+        REQUIRE(!w.err());
+        REQUIRE(w.size() == expected.pos());
+        REQUIRE(w.pos() == expected.pos() - blob.size() - text.size() - 800);
+
+        const auto segments = w.segments();
+        // own, blob, own, text, own, vector<uint64_t>
+        REQUIRE(segments.size() == 6);
+        REQUIRE(segments[1].data() == blob.data());
+        REQUIRE(segments[3].size() == text.size());
+        REQUIRE(concat(segments) == std::vector<std::byte>(expected.bytes().begin(),
+                                                           expected.bytes().end()));
+
+        w.clear();
+        REQUIRE(w.size() == 0);
+        REQUIRE(w.segments().empty());
+    }
+
+    SECTION("threshold")
+    {
+        gather_binary_writer w{2000};
+        write_message(w);
+        REQUIRE(w.segments().size() == 1);
+        REQUIRE(w.size() == w.pos());
+        REQUIRE(concat(w.segments()) == std::vector<std::byte>(expected.bytes().begin(),
+                                                               expected.bytes().end()));
+    }
+
+#if !defined(_WIN32)
+    SECTION("writev")
+    {
+        gather_binary_writer w;
+        write_message(w);
+
+        std::vector<::iovec> iov;
+        for (const auto& segment : w.segments())
+            iov.push_back({const_cast<std::byte*>(segment.data()), segment.size()});
+
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        REQUIRE(::writev(fds[1], iov.data(), static_cast<int>(iov.size())) ==
+                static_cast<::ssize_t>(w.size()));
+        ::close(fds[1]);
+
+        stream_binary_reader r{fds[0]};
+        REQUIRE(r.read<std::uint32_t>() == 1);
+        REQUIRE(r.read<std::string>() == "small");
+        REQUIRE(r.read<std::uint32_t>() == blob.size());
+        r.skip(static_cast<std::ptrdiff_t>(blob.size()));
+        REQUIRE(r.read<std::string>() == text);
+        REQUIRE(r.read<std::vector<std::uint16_t>>() == small);
+        REQUIRE(r.read<std::vector<std::uint64_t>>() == large);
+        REQUIRE(!r.err());
+        REQUIRE(r.at_end());
+        ::close(fds[0]);
+    }
+#endif
+}
+
+TEST_CASE("crc32c")
+{
+    using namespace kl;
+
+    auto bytes = [](std::string_view str) { return gsl::as_bytes(gsl::span{str}); };
+
+    // Bit by bit definition to check every kernel against
+    auto reference = [](gsl::span<const std::byte> data) {
+        std::uint32_t crc = ~0U;
+        for (const auto b : data)
+        {
+            crc ^= std::to_integer<std::uint32_t>(b);
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (crc & 1 ? 0x82F63B78 : 0);
+        }
+        return ~crc;
+    };
+
+    REQUIRE(crc32c({}) == 0);
+    REQUIRE(crc32c(bytes("123456789")) == 0xE3069283);
+    REQUIRE(crc32c(gsl::as_bytes(gsl::span{std::array<std::uint8_t, 32>{}})) == 0x8A9136AA);
+
+    std::vector<std::byte> data(100);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<std::byte>(i * 37 + 11);
+
+    const auto full = crc32c(data);
+    REQUIRE(full == reference(data));
+    for (std::size_t size = 0; size <= data.size(); ++size)
+    {
+        const auto span = gsl::span<const std::byte>{data};
+        REQUIRE(crc32c(span.first(size)) == reference(span.first(size)));
+        REQUIRE(crc32c(span.subspan(size), crc32c(span.first(size))) == full);
+    }
+
+    // crc32c() only runs the best kernel so check the others directly
+    const auto kernels = detail::crc32c_kernels();
+    REQUIRE(!kernels.empty());
+    for (const auto kernel : kernels)
+    {
+        for (std::size_t offset = 0; offset < 8; ++offset)
+        {
+            for (std::size_t size = 0; offset + size <= data.size(); ++size)
+            {
+                const auto span = gsl::span<const std::byte>{data}.subspan(offset, size);
+                REQUIRE(~kernel(span.data(), span.size(), ~0U) == reference(span));
+            }
+        }
+    }
+}
+
+TEST_CASE("binary_reader/writer - frame")
+{
+    using namespace kl;
+
+    growable_binary_writer w;
+    REQUIRE(write_frame(w, std::string{"first"}));
+    const auto second = begin_frame(w);
+    w << std::uint32_t{2} << std::vector<std::uint16_t>{1, 2, 3};
+    REQUIRE(end_frame(w, second));
+    REQUIRE(write_frame(w, std::string{"third"}));
+    REQUIRE(!w.err());
+
+    auto data = w.release();
+
+    SECTION("round trip")
+    {
+        binary_reader r{data};
+
+        auto frame = read_frame(r);
+        REQUIRE(frame);
+        REQUIRE(frame->read<std::string>() == "first");
+        REQUIRE(frame->empty());
+
+        frame = read_frame(r);
+        REQUIRE(frame);
+        REQUIRE(frame->read<std::uint32_t>() == 2);
+        REQUIRE(frame->read<std::vector<std::uint16_t>>() == std::vector<std::uint16_t>{1, 2, 3});
+        REQUIRE(!frame->err());
+
+        frame = read_frame(r);
+        REQUIRE(frame);
+        REQUIRE(frame->read<std::string>() == "third");
+        REQUIRE(r.empty());
+        REQUIRE(!r.err());
+    }
+
+    SECTION("corrupted payload is skipped")
+    {
+        data[frame_header_size + 2] ^= 0x01_b;
+
+        binary_reader r{data};
+        REQUIRE(!read_frame(r));
+        REQUIRE(!r.err());
+
+        auto frame = read_frame(r);
+        REQUIRE(frame);
+        REQUIRE(frame->read<std::uint32_t>() == 2);
+        frame = read_frame(r);
+        REQUIRE(frame);
+        REQUIRE(frame->read<std::string>() == "third");
+        REQUIRE(r.empty());
+    }
+
+    SECTION("corrupted checksum")
+    {
+        data[second + sizeof(std::uint32_t)] ^= 0x80_b;
+
+        binary_reader r{data};
+        REQUIRE(read_frame(r));
+        REQUIRE(!read_frame(r));
+        REQUIRE(read_frame(r));
+        REQUIRE(!r.err());
+    }
+
+    SECTION("truncated")
+    {
+        binary_reader r{gsl::span<const std::byte>{data}.first(data.size() - 1)};
+        REQUIRE(read_frame(r));
+        REQUIRE(read_frame(r));
+        REQUIRE(!read_frame(r));
+        REQUIRE(r.err());
+    }
+
+    SECTION("gather_binary_writer")
+    {
+        const std::string text(1000, 'x');
+        gather_binary_writer gw;
+
+        // Big spans are copied while in a frame so that the checksum covers them
+        REQUIRE(write_frame(gw, text));
+        REQUIRE(gw.segments().size() == 1);
+        gw << text;
+        REQUIRE(gw.segments().size() == 2);
+
+        const auto segments = gw.segments();
+        std::vector<std::byte> bytes(segments[0].begin(), segments[0].end());
+        binary_reader r{bytes};
+        auto frame = read_frame(r);
+        REQUIRE(frame);
+        REQUIRE(frame->read<std::string>() == text);
+    }
+
+    SECTION("unfinished frame")
+    {
+        std::byte buffer[4];
+        binary_writer bw{buffer};
+        const auto frame = begin_frame(bw);
+        REQUIRE(bw.err());
+        REQUIRE(!end_frame(bw, frame));
+    }
+
+    SECTION("stream")
+    {
+        std::size_t offset = 0;
+        stream_binary_reader r{[&](gsl::span<std::byte> buffer) -> std::ptrdiff_t {
+                                   // Trickle the data to split frames across refills
+                                   const auto size = (std::min)(buffer.size(), std::size_t{3});
+                                   const auto n = (std::min)(size, data.size() - offset);
+                                   std::memcpy(buffer.data(), data.data() + offset, n);
+                                   offset += n;
+                                   return static_cast<std::ptrdiff_t>(n);
+                               },
+                               64};
+
+        std::vector<std::size_t> sizes;
+        while (!r.at_end())
+        {
+            const auto frame = read_frame(r);
+            REQUIRE(frame);
+            sizes.push_back(frame->left());
+        }
+        REQUIRE(sizes == std::vector<std::size_t>{9, 14, 9});
+        REQUIRE(!r.err());
+    }
+}
+
+TEST_CASE("binary_reader/writer - delta encoded")
+{
+    using namespace kl;
+
+    auto round_trip = [](const auto& values) {
+        using vector = std::decay_t<decltype(values)>;
+
+        growable_binary_writer w;
+        w << delta_encoded<vector>{values};
+        REQUIRE(!w.err());
+        REQUIRE(w.pos() == binary_size(delta_encoded<vector>{values}));
+
+        binary_reader r{w.bytes()};
+        const auto decoded = r.read<delta_encoded<vector>>();
+        REQUIRE(!r.err());
+        REQUIRE(r.empty());
+        REQUIRE(decoded.value() == values);
+        return w.pos();
+    };
+
+    SECTION("timestamps")
+    {
+        std::vector<std::int64_t> timestamps(1000);
+        for (std::size_t i = 0; i < timestamps.size(); ++i)
+            timestamps[i] = 1'700'000'000'000'000 + static_cast<std::int64_t>(i * 1000 + i % 7);
+
+        // 8 bytes for the first value, 3 bits per delta and block headers
+        REQUIRE(round_trip(timestamps) < 8 + timestamps.size() * 3 / 8 + 8 * 5);
+    }
+
+    SECTION("edge cases")
+    {
+        round_trip(std::vector<std::int64_t>{});
+        round_trip(std::vector<std::int64_t>{-5});
+        round_trip(std::vector<std::int64_t>{(std::numeric_limits<std::int64_t>::min)(),
+                                             (std::numeric_limits<std::int64_t>::max)(), 0,
+                                             (std::numeric_limits<std::int64_t>::min)()});
+        round_trip(std::vector<std::uint64_t>{(std::numeric_limits<std::uint64_t>::max)(), 0, 1});
+        round_trip(std::vector<std::uint8_t>{0, 255, 1, 254});
+        round_trip(std::vector<std::int16_t>{-32768, 32767, 0});
+
+        // Every bit width of offsets
+        std::vector<std::uint64_t> widths;
+        std::uint64_t value = 0;
+        for (unsigned bits = 0; bits <= 64; ++bits)
+        {
+            for (std::size_t i = 0; i < detail::delta_block_size; ++i)
+            {
+                widths.push_back(value);
+                const auto offset = bits ? (i * 0x9E3779B97F4A7C15ULL) >> (64 - bits) : 0;
+                value += 5 + offset;
+            }
+        }
+        round_trip(widths);
+
+        // Exactly one and a bit more than one block
+        std::vector<std::uint32_t> ids(detail::delta_block_size + 1);
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            ids[i] = static_cast<std::uint32_t>(i * i);
+        round_trip(ids);
+        ids.push_back(0);
+        round_trip(ids);
+    }
+
+    SECTION("compact encoding")
+    {
+        growable_binary_writer w;
+        w.set_encoding(binary_encoding::compact);
+        write_delta_encoded(w, gsl::span<const std::int32_t>{std::vector<std::int32_t>{3, 2}});
+        // length, first value, smallest delta, bit width of offsets from it
+        const std::vector<std::byte> expected{2_b, 6_b, 1_b, 0_b};
+        REQUIRE(w.bytes() == gsl::span<const std::byte>{expected});
+    }
+
+    SECTION("invalid")
+    {
+        std::vector<std::int64_t> values(300);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<std::int64_t>(i) * 3;
+
+        growable_binary_writer w;
+        write_delta_encoded(w, gsl::span<const std::int64_t>{values});
+        const auto data = w.release();
+
+        for (std::size_t size = 0; size < data.size(); ++size)
+        {
+            binary_reader r{gsl::span<const std::byte>{data}.first(size)};
+            std::vector<std::int64_t> decoded;
+            REQUIRE(!read_delta_encoded(r, decoded));
+            REQUIRE(r.err());
+            REQUIRE(decoded.empty());
+        }
+
+        // Delta too big for the element type
+        growable_binary_writer w2;
+        write_delta_encoded(w2, gsl::span<const std::int64_t>{std::vector<std::int64_t>{0, 40000}});
+        binary_reader r{w2.bytes()};
+        std::vector<std::int16_t> narrow;
+        REQUIRE(!read_delta_encoded(r, narrow));
+        REQUIRE(r.err());
+
+        // Corrupted length, nothing is allocated for it up front
+        std::array<std::byte, 5> huge = {0xff_b, 0xff_b, 0xff_b, 0xff_b, 0x02_b};
+        binary_reader r2{huge};
+        std::vector<std::int64_t> decoded;
+        REQUIRE(!read_delta_encoded(r2, decoded));
+        REQUIRE(r2.err());
+        REQUIRE(decoded.capacity() < 1024);
+    }
+}
@@ -61,4 +61,49 @@ TEST_CASE("file_view")
 
         REQUIRE(str == "Test\nHello.");
     }
+
+    SECTION("read file with access hints")
+    {
+        std::string contents(1024 * 1024, 'x');
+        for (std::size_t i = 0; i < contents.size(); i += 4096)
+            contents[i] = static_cast<char>('a' + i / 4096 % 26);
+        {
+            std::ofstream strm{"test-hints.tmp", std::ios::trunc | std::ios::out |
+                                                     std::ios::binary};
+            strm << contents;
+        }
+
+        auto read_all = [](const kl::file_view& view) {
+            const auto s = view.get_bytes();
+            return std::string{reinterpret_cast<const char*>(s.data()), s.size_bytes()};
+        };
+
+        for (const auto access : {kl::file_access::normal, kl::file_access::sequential,
+                                  kl::file_access::random})
+        {
+            kl::file_view_options opts;
+            opts.access = access;
+            opts.populate = access == kl::file_access::sequential;
+            opts.huge_pages = true;
+
+            kl::file_view view{"test-hints.tmp", opts};
+            REQUIRE(read_all(view) == contents);
+        }
+
+        kl::file_view view{"test-hints.tmp", {kl::file_access::sequential}};
+        // Any range, including unaligned and out of bounds ones
+        view.prefetch(0, 64 * 1024);
+        view.prefetch(4097, 100);
+        view.prefetch(contents.size() - 1, 1024 * 1024);
+        view.prefetch(contents.size(), 1);
+        view.prefetch(0, 0);
+        REQUIRE(read_all(view) == contents);
+
+        {
+            std::ofstream{"test-hints-empty.tmp", std::ios::trunc | std::ios::out};
+        }
+        kl::file_view empty_view{"test-hints-empty.tmp", {kl::file_access::sequential, true}};
+        empty_view.prefetch(0, 100);
+        REQUIRE(empty_view.get_bytes().empty());
+    }
 }
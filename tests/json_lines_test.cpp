@@ -0,0 +1,206 @@
+#include "kl/json_lines.hpp"
+#include "kl/file_view.hpp"
+#include "kl/reflect_struct.hpp"
+#include "kl/serialization_error.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <ios>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct json_lines_record
+{
+    int id = 0;
+    std::string name;
+};
+KL_REFLECT_STRUCT(json_lines_record, id, name)
+
+namespace {
+
+using record = json_lines_record;
+
+std::string make_lines(int count)
+{
+    std::string text;
+    for (int i = 0; i < count; ++i)
+        text += R"({"id": )" + std::to_string(i) + R"(, "name": "record)" + std::to_string(i) +
+                "\"}\n";
+    return text;
+}
+} // namespace
+
+TEST_CASE("json::for_each_line")
+{
+    using namespace kl;
+
+    SECTION("empty input")
+    {
+        int count = 0;
+        json::for_each_line<record>("", [&](record&&) { ++count; });
+        json::for_each_line<record>("\n \r\n\n", [&](record&&) { ++count; });
+        CHECK(count == 0);
+    }
+
+    SECTION("single line without trailing newline")
+    {
+        std::vector<record> records;
+        json::for_each_line<record>(R"({"id": 3, "name": "x"})",
+                                    [&](record&& r) { records.push_back(std::move(r)); });
+        REQUIRE(records.size() == 1);
+        CHECK(records[0].id == 3);
+        CHECK(records[0].name == "x");
+    }
+
+    SECTION("preserved order")
+    {
+        const auto text = make_lines(1000);
+
+        for (unsigned num_threads : {1u, 2u, 8u})
+        {
+            json::lines_options opts;
+            opts.num_threads = num_threads;
+            opts.chunk_size = 256;
+
+            std::vector<record> records;
+            json::for_each_line<record>(
+                text, [&](record&& r) { records.push_back(std::move(r)); }, opts);
+
+            REQUIRE(records.size() == 1000);
+            for (int i = 0; i < 1000; ++i)
+            {
+                CHECK(records[i].id == i);
+                CHECK(records[i].name == "record" + std::to_string(i));
+            }
+        }
+    }
+
+    SECTION("unordered")
+    {
+        const auto text = make_lines(1000);
+
+        json::lines_options opts;
+        opts.num_threads = 4;
+        opts.chunk_size = 100;
+        opts.order = json::lines_order::unordered;
+
+        std::mutex mutex;
+        std::vector<int> ids;
+        json::for_each_line<record>(
+            text,
+            [&](record&& r) {
+                std::lock_guard lock{mutex};
+                ids.push_back(r.id);
+            },
+            opts);
+
+        std::sort(ids.begin(), ids.end());
+        REQUIRE(ids.size() == 1000);
+        for (int i = 0; i < 1000; ++i)
+            CHECK(ids[i] == i);
+    }
+
+    SECTION("blank lines and CRLF")
+    {
+        const std::string text = "\r\n{\"id\": 1, \"name\": \"\"}\r\n\r\n  \n"
+                                 "{\"id\": 2, \"name\": \"\"}\r\n";
+        std::vector<int> ids;
+        json::for_each_line<record>(text, [&](record&& r) { ids.push_back(r.id); });
+        CHECK(ids == std::vector<int>{1, 2});
+    }
+
+    SECTION("errors report the first bad line")
+    {
+        auto text = make_lines(500);
+        text += "{\"id\": \"x\", \"name\": \"\"}\n";
+        text += make_lines(500);
+        text += "{\"id\": 1, \"name\": \"\",\n";
+
+        json::lines_options opts;
+        opts.num_threads = 4;
+        opts.chunk_size = 128;
+
+        std::vector<record> records;
+        try
+        {
+            json::for_each_line<record>(
+                text, [&](record&& r) { records.push_back(std::move(r)); }, opts);
+            FAIL("exception should have been thrown");
+        }
+        catch (const serialization::deserialize_error& ex)
+        {
+            CHECK(std::string{ex.what()} == "type must be an integral but is a kStringType\n"
+                                            "error when deserializing field id\n"
+                                            "error when deserializing type json_lines_record\n"
+                                            "error when deserializing line 501");
+        }
+
+        // Everything preceding the bad line was delivered in order
+        REQUIRE(records.size() == 500);
+        CHECK(records.back().id == 499);
+
+        const std::string bad_syntax = "{\"id\": 1, \"name\": \"\"}\n\n{\"id\": 2,]\n";
+        try
+        {
+            json::for_each_line<record>(bad_syntax, [](record&&) {});
+            FAIL("exception should have been thrown");
+        }
+        catch (const serialization::parse_error& ex)
+        {
+            CHECK(std::string{ex.what()}.find("error when deserializing line 3") !=
+                  std::string::npos);
+        }
+    }
+
+    SECTION("callback exception")
+    {
+        const auto text = make_lines(100);
+
+        json::lines_options opts;
+        opts.num_threads = 2;
+        opts.chunk_size = 64;
+
+        int count = 0;
+        CHECK_THROWS_AS(json::for_each_line<record>(
+                            text,
+                            [&](record&&) {
+                                if (++count == 10)
+                                    throw std::runtime_error{"stop"};
+                            },
+                            opts),
+                        std::runtime_error);
+        CHECK(count == 10);
+
+        // Takes precedence over a bad line workers may have already reached
+        const auto bad_text = make_lines(3) + "{\"id\": \"x\", \"name\": \"\"}\n" + text;
+        CHECK_THROWS_AS(json::for_each_line<record>(
+                            bad_text, [&](record&&) { throw std::runtime_error{"stop"}; }, opts),
+                        std::runtime_error);
+
+        // Rethrown as is, without pointing at a line
+        opts.order = json::lines_order::unordered;
+        CHECK_THROWS_WITH(json::for_each_line<record>(
+                              text,
+                              [&](record&&) { throw serialization::deserialize_error{"stop"}; },
+                              opts),
+                          "stop");
+    }
+
+    SECTION("file_view")
+    {
+        {
+            std::ofstream strm{"test_lines.tmp",
+                               std::ios::trunc | std::ios::out | std::ios::binary};
+            strm << make_lines(50);
+        }
+
+        kl::file_view view{"test_lines.tmp"};
+        int sum = 0;
+        json::for_each_line<record>(view, [&](record&& r) { sum += r.id; });
+        CHECK(sum == 49 * 50 / 2);
+    }
+}
@@ -10,9 +10,11 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 #include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
@@ -20,6 +22,7 @@
 #include <array>
 #include <cstdint>
 #include <deque>
+#include <limits>
 #include <list>
 #include <map>
 #include <optional>
@@ -1330,3 +1333,694 @@ TEST_CASE("json serialize owns dynamic map keys", "[json][serialization]")
     // With the current json_tree_backend::add_field implementation, it does.
     CHECK(member_it->name.GetString() != it->first.c_str());
 }
+
+namespace {
+
+namespace attr = kl::serialization::attributes;
+
+struct load_record
+{
+    int id{};
+    std::string label;
+    std::vector<int> values;
+    int count{};
+    int even{};
+    std::optional<inner_t> inner;
+    std::map<std::string, int> extra;
+};
+
+KL_REFLECT_STRUCT(load_record,
+                  id,
+                  (label, attr::rename("name"), attr::aliases("title", "caption")),
+                  (values, attr::aliases("vals")),
+                  (count, attr::default_value(42)),
+                  (even, attr::allow_missing, attr::validate([](int value) {
+                       if (value % 2)
+                           throw kl::serialization::deserialize_error{"value must be even"};
+                   })),
+                  inner,
+                  (extra, attr::extra_fields))
+
+struct load_skipped_record
+{
+    int a{};
+    int skipped{13};
+};
+
+KL_REFLECT_STRUCT(load_skipped_record, a, (skipped, attr::skip_deserialization))
+
+struct load_flattened_record
+{
+    int a{};
+    inner_t inner;
+};
+
+KL_REFLECT_STRUCT(load_flattened_record, a, (inner, attr::flatten))
+
+template <typename T>
+std::string load_error(std::string_view text)
+{
+    try
+    {
+        kl::json::load<T>(text);
+    }
+    catch (std::exception& ex)
+    {
+        return ex.what();
+    }
+    return {};
+}
+
+template <typename T>
+std::string deserialize_error(std::string_view text)
+{
+    try
+    {
+        kl::json::deserialize<T>(kl::json::parse(text));
+    }
+    catch (std::exception& ex)
+    {
+        return ex.what();
+    }
+    return {};
+}
+} // namespace
+
+TEST_CASE("json::load", "[json][serialization]")
+{
+    using namespace kl;
+
+    SECTION("basic types")
+    {
+        CHECK(json::load<int>("-1") == -1);
+        CHECK(json::load<std::string>(R"("str\"ing")") == "str\"ing");
+        CHECK(json::load<unsigned>(" 33 ") == 33U);
+        CHECK(json::load<bool>("true"));
+        CHECK(json::load<double>("13.11") == Catch::Approx{13.11});
+        CHECK(json::load<colour_space>(R"("hsv")") == colour_space::hsv);
+        CHECK(json::load<ordinary_enum>("0") == ordinary_enum::oe_one);
+        CHECK(!json::load<std::optional<int>>("null"));
+    }
+
+    SECTION("complex structure")
+    {
+        test_t t;
+        t.hello = "dlrow";
+        t.n = 7;
+        t.a = {5, 6};
+        t.ad = {{}, {1}};
+        t.space = colour_space::xyz;
+        t.tup = std::make_tuple(2, 2.5, "ASD");
+        t.map = {{"x", colour_space::luv}};
+        t.inner.r = -3;
+        const auto text = json::dump(t);
+
+        const auto loaded = json::load<test_t>(text);
+        CHECK(json::dump(loaded) == text);
+
+        std::vector<test_t> many(3, t);
+        CHECK(json::dump(json::load<std::vector<test_t>>(json::dump(many))) ==
+              json::dump(many));
+    }
+
+    SECTION("std containers")
+    {
+        CHECK(json::load<std::array<std::optional<int>, 3>>("[1, 2]") ==
+              std::array<std::optional<int>, 3>{1, 2, std::nullopt});
+        CHECK(json::load<std::list<std::string>>(R"(["a", "b"])") ==
+              std::list<std::string>{"a", "b"});
+        CHECK(json::load<std::unordered_map<std::string, std::vector<int>>>(
+                  R"({"a": [1], "b": []})") ==
+              std::unordered_map<std::string, std::vector<int>>{{"a", {1}}, {"b", {}}});
+        CHECK(json::load<std::pair<int, bool>>("[3, true]") == std::pair{3, true});
+        CHECK(json::load<device_flags>(R"(["cpu", "gpu"])").underlying_value() ==
+              (kl::underlying_cast(device_type::cpu) | kl::underlying_cast(device_type::gpu)));
+    }
+
+    SECTION("attributes")
+    {
+        auto r = json::load<load_record>(
+            R"({"id": 1, "caption": "c", "title": "t", "vals": [1, 2], "inner": {"r": 5, "d": 1},
+                "unknown": 3, "even": 4})");
+        CHECK(r.id == 1);
+        CHECK(r.label == "t");
+        CHECK(r.values == std::vector<int>{1, 2});
+        CHECK(r.count == 42);
+        CHECK(r.even == 4);
+        REQUIRE(r.inner);
+        CHECK(r.inner->r == 5);
+        CHECK(r.extra == std::map<std::string, int>{{"unknown", 3}});
+
+        // Canonical name wins regardless of the order
+        r = json::load<load_record>(
+            R"({"id": 1, "title": "t", "name": "n", "values": [], "vals": [3], "count": null})");
+        CHECK(r.label == "n");
+        CHECK(r.values.empty());
+        CHECK(r.count == 42);
+        CHECK(!r.inner);
+        CHECK(r.extra.empty());
+
+        auto s = json::load<load_skipped_record>(R"({"a": 1, "skipped": 2})");
+        CHECK(s.a == 1);
+        CHECK(s.skipped == 13);
+
+        auto f = json::load<load_flattened_record>(R"({"a": 1, "r": 2, "d": 0.5})");
+        CHECK(f.a == 1);
+        CHECK(f.inner.r == 2);
+        CHECK(f.inner.d == Catch::Approx{0.5});
+    }
+
+    SECTION("unknown fields are skipped")
+    {
+        auto inn = json::load<inner_t>(
+            R"({"x": {"y": [1, {"z": []}], "w": "str"}, "r": 1, "q": [[]], "d": 2.0})");
+        CHECK(inn.r == 1);
+        CHECK(inn.d == Catch::Approx{2.0});
+    }
+
+    SECTION("user-defined deserialization")
+    {
+        auto z = json::load<zxc>(R"({"a":"asd","b":3,"c":true,"d":[1,2,34]})");
+        CHECK(z.a == "asd");
+        CHECK(z.d == std::vector<int>{1, 2, 34});
+
+        auto a = json::load<aggregate>(R"({"g": "global_struct", "n": null, "w": 31})");
+        CHECK(a.w.value == 31);
+    }
+
+    SECTION("errors match json::deserialize")
+    {
+        const char* inputs[] = {
+            R"(null)",
+            R"([1, 2])",
+            R"({"id": "1", "name": "n", "values": []})",
+            R"({"id": 1, "values": []})",
+            R"({"id": 1, "name": "n", "values": [1, "2"]})",
+            R"({"id": 1, "name": "n", "values": [], "even": 3})",
+            R"({"id": 1, "name": "n", "values": [], "inner": 3})",
+            R"({"id": 1, "name": "n", "values": [], "inner": {"r": 1.5}})",
+            R"({"id": 1, "name": "n", "values": [], "other": true})",
+        };
+        for (const char* input : inputs)
+        {
+            INFO(input);
+            CHECK(load_error<load_record>(input) == deserialize_error<load_record>(input));
+            CHECK(!load_error<load_record>(input).empty());
+        }
+
+        CHECK(load_error<std::array<int, 1>>("[1, 2]") ==
+              deserialize_error<std::array<int, 1>>("[1, 2]"));
+        CHECK(load_error<std::tuple<int>>("[1, 2]") ==
+              deserialize_error<std::tuple<int>>("[1, 2]"));
+        CHECK(load_error<std::map<std::string, int>>(R"({"a": []})") ==
+              deserialize_error<std::map<std::string, int>>(R"({"a": []})"));
+        CHECK(load_error<std::vector<int>>(R"({"a": []})") ==
+              deserialize_error<std::vector<int>>(R"({"a": []})"));
+        CHECK(load_error<colour_space>(R"("rgba")") ==
+              deserialize_error<colour_space>(R"("rgba")"));
+    }
+
+    SECTION("parse errors")
+    {
+        CHECK_THROWS_AS(json::load<int>(""), serialization::parse_error);
+        CHECK_THROWS_AS(json::load<int>("1 2"), serialization::parse_error);
+        CHECK_THROWS_AS(json::load<std::vector<int>>("[1, 2"), serialization::parse_error);
+        CHECK_THROWS_AS(json::load<inner_t>(R"({"r": 1,})"), serialization::parse_error);
+        CHECK_THROWS_AS(json::load<inner_t>(R"({"r": 1, "d": 2} x)"),
+                        serialization::parse_error);
+    }
+}
+
+TEST_CASE("json::arena", "[json][serialization]")
+{
+    using namespace kl;
+
+    const auto text = json::dump(std::vector<test_t>(8));
+
+    SECTION("parse, deserialize, serialize and dump")
+    {
+        json::arena arena{1024};
+
+        for (int cycle = 0; cycle < 3; ++cycle)
+        {
+            arena.reset();
+
+            auto& doc = json::parse(text, arena);
+            auto objs = json::deserialize<std::vector<test_t>>(doc);
+            REQUIRE(objs.size() == 8);
+            CHECK(objs[7].hello == "world");
+            CHECK(objs[7].map.at("2") == colour_space::rgb);
+
+            json::serialize_context ctx{arena};
+            auto value = json::serialize(objs, ctx);
+            CHECK(to_string(value) == text);
+            CHECK(json::dump(json::view{value}, arena) == text);
+            CHECK(json::dump(objs, arena) == text);
+        }
+    }
+
+    SECTION("grows to fit the workload once")
+    {
+        json::arena arena{1024};
+        const auto initial_capacity = arena.capacity();
+
+        auto cycle = [&] {
+            arena.reset();
+            auto objs = json::deserialize<std::vector<test_t>>(json::parse(text, arena));
+            json::serialize_context ctx{arena};
+            return to_string(json::serialize(objs, ctx));
+        };
+
+        CHECK(cycle() == text);
+        CHECK(cycle() == text);
+        const auto warm_capacity = arena.capacity();
+        CHECK(warm_capacity > initial_capacity);
+
+        for (int i = 0; i < 5; ++i)
+            CHECK(cycle() == text);
+        CHECK(arena.capacity() == warm_capacity);
+    }
+
+    SECTION("parse error")
+    {
+        json::arena arena;
+        CHECK_THROWS_AS(json::parse("[1, 2", arena), serialization::parse_error);
+        CHECK(json::parse("[1, 2]", arena).Size() == 2);
+    }
+}
+
+namespace {
+
+struct insitu_record
+{
+    std::string_view name;
+    std::vector<std::string_view> tags;
+    std::optional<std::string_view> note;
+    std::string copied;
+    int id = 0;
+};
+KL_REFLECT_STRUCT(insitu_record, name, tags, note, copied, id)
+} // namespace
+
+TEST_CASE("json::parse_insitu and json::load_insitu", "[json][serialization]")
+{
+    using namespace kl;
+
+    const std::string text =
+        R"({"name": "first\nsecond", "tags": ["a", "b\"c"], "copied": "xyz", "id": 7})";
+
+    auto in_buffer = [](const std::string& buffer, std::string_view str) {
+        return str.data() >= buffer.data() &&
+               str.data() + str.size() <= buffer.data() + buffer.size();
+    };
+
+    auto check_record = [&](const insitu_record& r, const std::string& buffer) {
+        CHECK(r.name == "first\nsecond");
+        CHECK(in_buffer(buffer, r.name));
+        REQUIRE(r.tags.size() == 2);
+        CHECK(r.tags[0] == "a");
+        CHECK(r.tags[1] == "b\"c");
+        CHECK(in_buffer(buffer, r.tags[1]));
+        CHECK(!r.note);
+        CHECK(r.copied == "xyz");
+        CHECK(r.id == 7);
+    };
+
+    SECTION("parse_insitu")
+    {
+        std::string buffer = text;
+        auto doc = json::parse_insitu(buffer);
+        check_record(json::deserialize<insitu_record>(doc), buffer);
+    }
+
+    SECTION("parse_insitu with arena")
+    {
+        std::string buffer = text;
+        json::arena arena;
+        check_record(json::deserialize<insitu_record>(json::parse_insitu(buffer, arena)),
+                     buffer);
+    }
+
+    SECTION("load_insitu")
+    {
+        std::string buffer = text;
+        check_record(json::load_insitu<insitu_record>(buffer), buffer);
+
+        buffer = R"(["x", "y"])";
+        auto strs = json::load_insitu<std::vector<std::string_view>>(buffer);
+        CHECK_THAT(strs, Catch::Matchers::Equals(std::vector<std::string_view>{"x", "y"}));
+    }
+
+    SECTION("buffer doesn't need to be null-terminated")
+    {
+        std::string buffer = R"([1, 2]xxx)";
+        auto span = gsl::span<char>{buffer}.first(6);
+        CHECK(json::parse_insitu(span).Size() == 2);
+
+        buffer = R"(["ab", "cd"]x)";
+        span = gsl::span<char>{buffer}.first(buffer.size() - 1);
+        CHECK(json::load_insitu<std::vector<std::string>>(span) ==
+              std::vector<std::string>{"ab", "cd"});
+
+        buffer = R"(["ab)";
+        CHECK_THROWS_AS(json::parse_insitu(buffer), serialization::parse_error);
+        buffer = R"(["ab)";
+        CHECK_THROWS_AS(json::load_insitu<std::vector<std::string_view>>(buffer),
+                        serialization::parse_error);
+    }
+
+    SECTION("errors")
+    {
+        std::string buffer = R"({"name": 1})";
+        CHECK_THROWS_AS(json::load_insitu<insitu_record>(buffer),
+                        serialization::deserialize_error);
+        buffer = R"({"name": "a", "tags": [], "copied": "", "id": 1} 1)";
+        CHECK_THROWS_AS(json::load_insitu<insitu_record>(buffer), serialization::parse_error);
+    }
+}
+
+TEST_CASE("json::parallel_deserialize_context", "[json][serialization]")
+{
+    using namespace kl;
+
+    std::vector<test_t> objs(300);
+    for (std::size_t i = 0; i < objs.size(); ++i)
+    {
+        objs[i].i = static_cast<int>(i);
+        objs[i].a.assign(i % 5, static_cast<int>(i));
+    }
+    const auto doc = json::serialize(objs);
+
+    SECTION("same result as sequential")
+    {
+        for (unsigned num_threads : {1u, 2u, 3u, 16u})
+        {
+            json::parallel_deserialize_context ctx{num_threads, 10};
+            auto res = json::deserialize<std::vector<test_t>>(doc, ctx);
+            CHECK(json::dump(res) == json::dump(objs));
+        }
+    }
+
+    SECTION("nested arrays")
+    {
+        std::vector<std::vector<int>> nested(50, std::vector<int>(50, 7));
+        nested[49][49] = 8;
+        json::parallel_deserialize_context ctx{4, 10};
+        CHECK(json::deserialize<decltype(nested)>(json::serialize(nested), ctx) == nested);
+    }
+
+    SECTION("below threshold")
+    {
+        json::parallel_deserialize_context ctx{4};
+        CHECK(json::deserialize<std::vector<int>>("[1, 2, 3]"_json, ctx) ==
+              std::vector<int>{1, 2, 3});
+    }
+
+    SECTION("reports the first failing element")
+    {
+        auto bad = json::serialize(objs);
+        bad[250]["i"].SetString("x");
+        bad[110]["inner"]["r"].SetString("x");
+        bad[20]["hello"].SetInt(1);
+
+        json::parallel_deserialize_context ctx{4, 10};
+        std::string parallel_error, sequential_error;
+        try
+        {
+            json::deserialize<std::vector<test_t>>(bad, ctx);
+        }
+        catch (const serialization::deserialize_error& ex)
+        {
+            parallel_error = ex.what();
+        }
+        try
+        {
+            json::deserialize<std::vector<test_t>>(bad);
+        }
+        catch (const serialization::deserialize_error& ex)
+        {
+            sequential_error = ex.what();
+        }
+
+        CHECK(parallel_error == sequential_error);
+        CHECK_THAT(parallel_error,
+                   Catch::Matchers::EndsWith("error when deserializing element 20"));
+    }
+}
+
+namespace {
+
+struct quoted_keys_record
+{
+    int plain = 1;
+    int quote = 2;
+    int control = 3;
+    int skipped = 4;
+    inner_t inner;
+    std::map<std::string, int> extra{{"x\"y", 5}};
+};
+
+KL_REFLECT_STRUCT(quoted_keys_record,
+                  plain,
+                  (quote, attr::rename("a\"b\\c")),
+                  (control, attr::rename("tab\there\x01")),
+                  (skipped, attr::skip_serialization),
+                  (inner, attr::flatten),
+                  (extra, attr::extra_fields))
+
+struct non_ascii_keys_record
+{
+    int a = 1;
+    int b = 2;
+};
+
+KL_REFLECT_STRUCT(non_ascii_keys_record, a, (b, attr::rename("zażółć")))
+
+template <typename Writer>
+std::string write_quoted_keys_record()
+{
+    rapidjson::StringBuffer buffer;
+    Writer w{buffer};
+    w.StartObject();
+    w.Key("plain");
+    w.Int(1);
+    w.Key("a\"b\\c");
+    w.Int(2);
+    w.Key("tab\there\x01");
+    w.Int(3);
+    w.Key("r");
+    w.Int(1337);
+    w.Key("d");
+    w.Double(3.145926);
+    w.Key("x\"y");
+    w.Int(5);
+    w.EndObject();
+    return buffer.GetString();
+}
+} // namespace
+
+TEST_CASE("json dump - precomputed field keys", "[json][serialization]")
+{
+    using namespace kl;
+    using keys = json::detail::quoted_field_keys<quoted_keys_record>;
+
+    static_assert(keys::data.ascii);
+    static_assert(!json::detail::quoted_field_keys<non_ascii_keys_record>::data.ascii);
+    CHECK(keys::get(0) == R"("plain")");
+    CHECK(keys::get(1) == R"("a\"b\\c")");
+    CHECK(keys::get(2) == R"("tab\there\u0001")");
+    CHECK(keys::get(3).empty());
+    CHECK(keys::get(4).empty());
+    CHECK(keys::get(5).empty());
+
+    // Must be exactly what rapidjson's Writer::Key() would produce
+    CHECK(json::dump(quoted_keys_record{}) ==
+          write_quoted_keys_record<rapidjson::Writer<rapidjson::StringBuffer>>());
+    CHECK(json::pretty_dump(quoted_keys_record{}) ==
+          write_quoted_keys_record<rapidjson::PrettyWriter<rapidjson::StringBuffer>>());
+    CHECK(json::dump(non_ascii_keys_record{}) == R"({"a":1,"zażółć":2})");
+    CHECK(json::dump(std::vector<quoted_keys_record>(2)) ==
+          "[" + json::dump(quoted_keys_record{}) + "," + json::dump(quoted_keys_record{}) + "]");
+}
+
+struct string_writer_record
+{
+    std::int64_t min = std::numeric_limits<std::int64_t>::min();
+    std::int64_t max = std::numeric_limits<std::int64_t>::max();
+    std::uint64_t umax = std::numeric_limits<std::uint64_t>::max();
+    int zero = 0;
+    int negative = -1234567;
+    unsigned u = 9;
+    std::optional<int> none;
+    bool b = true;
+    std::string text = "esc\"ape\\ \b\f\n\r\t\x01\x1f/\x7f zażółć";
+    std::vector<std::vector<int>> nested = {{}, {1}, {22, 333}};
+    std::map<std::string, std::string> map = {{"k\"1", "v"}, {"k2", ""}};
+    colour_space space = colour_space::hsv;
+};
+KL_REFLECT_STRUCT(string_writer_record, min, max, umax, zero, negative, u, none, b, text, nested,
+                  map, space)
+
+TEST_CASE("json::string_writer", "[json][serialization]")
+{
+    using namespace kl;
+
+    auto dump = [](const auto& obj) {
+        json::string_writer writer;
+        json::dump_context ctx{writer};
+        json::dump(obj, ctx);
+        CHECK(writer.IsComplete());
+        return std::string{writer.str()};
+    };
+
+    SECTION("same output as rapidjson::Writer")
+    {
+        const string_writer_record rec;
+        CHECK(dump(rec) == json::dump(rec));
+        CHECK(dump(std::vector<string_writer_record>(3)) ==
+              json::dump(std::vector<string_writer_record>(3)));
+        CHECK_THAT(dump(quoted_keys_record{}),
+                   Catch::Matchers::StartsWith(R"({"plain":1,"a\"b\\c":2,"tab\there\u0001":3,)"));
+        CHECK(dump(std::vector<int>{}) == "[]");
+        CHECK(dump(std::string{"a"}) == R"("a")");
+        CHECK(dump(nullptr) == "null");
+
+        for (std::int64_t v = 1; v > 0 && v < std::numeric_limits<std::int64_t>::max() / 10;
+             v = v * 10 + 1)
+        {
+            CHECK(dump(v) == std::to_string(v));
+            CHECK(dump(-v) == std::to_string(-v));
+            CHECK(dump(v - 1) == std::to_string(v - 1));
+        }
+
+        const auto doc = json::parse(json::dump(rec));
+        CHECK(dump(json::view{doc}) == json::dump(rec));
+    }
+
+    SECTION("doubles round-trip")
+    {
+        for (double d : {0.0, -0.0, 1.0, -2.5, 0.1, 1.0 / 3, 3.141592653589793, 1e-7, 5e-324,
+                         1e21, 1.7976931348623157e308, 123456789.125, 100000.0})
+        {
+            const auto text = dump(d);
+            CHECK(text.find_first_of(".e") != std::string::npos);
+            CHECK(json::deserialize<double>(json::parse(text)) == d);
+        }
+        CHECK(dump(1.0) == "1.0");
+        CHECK(dump(-0.0) == "-0.0");
+        CHECK(dump(0.1) == "0.1");
+        CHECK(dump(std::vector<double>{0.5, 2}) == "[0.5,2.0]");
+        CHECK(dump(3.1416f) == json::dump(3.1416f));
+
+        json::string_writer writer;
+        CHECK_FALSE(writer.Double(std::numeric_limits<double>::quiet_NaN()));
+        CHECK_FALSE(writer.Double(std::numeric_limits<double>::infinity()));
+        CHECK(writer.str().empty());
+    }
+
+    SECTION("release and reset")
+    {
+        json::string_writer writer;
+        json::dump_context ctx{writer};
+        json::dump(std::vector<int>{1, 2}, ctx);
+        CHECK(writer.release() == "[1,2]");
+        CHECK(writer.str().empty());
+        CHECK_FALSE(writer.IsComplete());
+
+        json::dump(inner_t{}, ctx);
+        writer.Reset();
+        json::dump(std::vector<int>{3}, ctx);
+        CHECK(writer.str() == "[3]");
+    }
+}
+
+TEST_CASE("json::try_deserialize", "[json][serialization]")
+{
+    using namespace kl;
+
+    // Status message must match what the throwing path reports
+    auto thrown_message = [](auto& out, const rapidjson::Value& j) -> std::string {
+        try
+        {
+            json::deserialize(out, j);
+        }
+        catch (const serialization::deserialize_error& ex)
+        {
+            return ex.what();
+        }
+        return {};
+    };
+
+    SECTION("success")
+    {
+        inner_t obj;
+        auto status = json::try_deserialize(obj, R"({"d": 1.0, "r": 2})"_json);
+        REQUIRE(status);
+        CHECK_FALSE(status.failed());
+        CHECK(status.message().empty());
+        CHECK(obj.r == 2);
+        CHECK(obj.d == 1.0);
+    }
+
+    SECTION("missing field")
+    {
+        const auto j = R"({"d": 1.0})"_json;
+        inner_t obj;
+        auto status = json::try_deserialize(obj, j);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == "type must be an integral but is a Null\n"
+                                  "error when deserializing field r\n"
+                                  "error when deserializing type " +
+                                      kl::ctti::name<inner_t>());
+        CHECK(status.message() == thrown_message(obj, j));
+        CHECK_THROWS_WITH(status.raise(), status.message());
+    }
+
+    SECTION("lossy conversion in nested sequence")
+    {
+        const auto j =
+            R"([{"r": 1, "d": 2.0}, {"r": 3, "d": 3.0}, {"r": 4294967296, "d": 4.0}])"_json;
+        std::vector<inner_t> vec;
+        auto status = json::try_deserialize(vec, j);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == "value cannot be losslessly stored in the variable\n"
+                                  "error when deserializing field r\n"
+                                  "error when deserializing type " +
+                                      kl::ctti::name<inner_t>() +
+                                      "\nerror when deserializing element 2");
+        CHECK(status.message() == thrown_message(vec, j));
+    }
+
+    SECTION("map and tuple")
+    {
+        std::map<std::string, std::tuple<int, std::string>> map;
+        REQUIRE(json::try_deserialize(map, R"({"a": [1, "x"], "b": [2, "y"]})"_json));
+        CHECK(map.size() == 2);
+
+        const auto bad = R"({"a": [1, "x"], "b": ["y", 2]})"_json;
+        auto status = json::try_deserialize(map, bad);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == thrown_message(map, bad));
+    }
+
+    SECTION("manually deserialized type falls back to exceptions")
+    {
+        const auto j = R"({"a": "asd", "b": 3, "c": 3, "d": [1]})"_json;
+        zxc z;
+        auto status = json::try_deserialize(z, j);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == thrown_message(z, j));
+    }
+
+    SECTION("reuse status")
+    {
+        json::deserialize_context ctx;
+        serialization::deserialize_status status;
+        int i = 0;
+        CHECK_FALSE(json::try_deserialize(i, "[1]"_json, ctx, status));
+        CHECK(status.message() == "type must be an integral but is a Array");
+        CHECK(json::try_deserialize(i, "7"_json, ctx, status));
+        CHECK(status);
+        CHECK(i == 7);
+    }
+}
@@ -0,0 +1,345 @@
+#include "kl/msgpack.hpp"
+#include "kl/ctti.hpp"
+#include "kl/enum_set.hpp"
+#include "kl/serialization_error.hpp"
+#include "input/typedefs.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+std::vector<std::byte> bytes(std::initializer_list<int> list)
+{
+    std::vector<std::byte> ret;
+    for (auto b : list)
+        ret.push_back(static_cast<std::byte>(b));
+    return ret;
+}
+
+template <typename T>
+T round_trip(const T& obj)
+{
+    const auto buffer = kl::msgpack::dump(obj);
+    return kl::msgpack::deserialize<T>(kl::msgpack::parse(buffer));
+}
+} // namespace
+
+TEST_CASE("msgpack", "[msgpack][serialization]")
+{
+    using namespace kl;
+
+    SECTION("dump basic types")
+    {
+        CHECK(msgpack::dump(0) == bytes({0x00}));
+        CHECK(msgpack::dump(127) == bytes({0x7f}));
+        CHECK(msgpack::dump(128) == bytes({0xcc, 0x80}));
+        CHECK(msgpack::dump(-1) == bytes({0xff}));
+        CHECK(msgpack::dump(-32) == bytes({0xe0}));
+        CHECK(msgpack::dump(-33) == bytes({0xd0, 0xdf}));
+        CHECK(msgpack::dump(std::uint16_t{0x1234}) == bytes({0xcd, 0x12, 0x34}));
+        CHECK(msgpack::dump(-70000) == bytes({0xd2, 0xff, 0xfe, 0xee, 0x90}));
+        CHECK(msgpack::dump(true) == bytes({0xc3}));
+        CHECK(msgpack::dump(false) == bytes({0xc2}));
+        CHECK(msgpack::dump(nullptr) == bytes({0xc0}));
+        CHECK(msgpack::dump(1.5f) == bytes({0xca, 0x3f, 0xc0, 0x00, 0x00}));
+        CHECK(msgpack::dump(1.5) ==
+              bytes({0xcb, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+        CHECK(msgpack::dump("abc") == bytes({0xa3, 'a', 'b', 'c'}));
+        CHECK(msgpack::dump(std::string(40, 'x')).size() == 42);
+        CHECK(msgpack::dump(std::string_view{"ab"}) == bytes({0xa2, 'a', 'b'}));
+        CHECK(msgpack::dump(colour_space::rgb) == bytes({0xa3, 'r', 'g', 'b'}));
+    }
+
+    SECTION("dump containers")
+    {
+        CHECK(msgpack::dump(std::vector<int>{}) == bytes({0x90}));
+        CHECK(msgpack::dump(std::vector<int>{1, 2}) == bytes({0x92, 0x01, 0x02}));
+        CHECK(msgpack::dump(std::map<std::string, bool>{{"a", true}}) ==
+              bytes({0x81, 0xa1, 'a', 0xc3}));
+        CHECK(msgpack::dump(std::make_tuple(1, "a")) == bytes({0x92, 0x01, 0xa1, 'a'}));
+        CHECK(msgpack::dump(inner_t{2, 0.5}) ==
+              bytes({0x82, 0xa1, 'r', 0x02, 0xa1, 'd', 0xcb, 0x3f, 0xe0, 0, 0, 0, 0, 0, 0}));
+
+        const auto v16 = msgpack::dump(std::vector<int>(16, 1));
+        REQUIRE(v16.size() == 3 + 16);
+        CHECK(v16[0] == std::byte{0xdc});
+        CHECK(v16[1] == std::byte{0x00});
+        CHECK(v16[2] == std::byte{0x10});
+
+        const auto v70k = msgpack::dump(std::vector<int>(70000, 1));
+        REQUIRE(v70k.size() == 5 + 70000);
+        CHECK(v70k[0] == std::byte{0xdd});
+    }
+
+    SECTION("nested containers")
+    {
+        msgpack::writer writer;
+        writer.begin_array();
+        writer.begin_map();
+        for (int i = 0; i < 16; ++i)
+        {
+            writer.uint64(static_cast<std::uint64_t>(i));
+            writer.begin_array();
+            writer.end_array();
+        }
+        writer.end_map();
+        writer.begin_array();
+        for (int i = 0; i < 70000; ++i)
+            writer.nil();
+        writer.end_array();
+        writer.boolean(true);
+        writer.end_array();
+        writer.nil();
+
+        const auto& buffer = writer.buffer();
+        REQUIRE(buffer.size() == 1 + (3 + 16 * 2) + (5 + 70000) + 1 + 1);
+        CHECK(buffer[0] == std::byte{0x93});
+        CHECK(buffer[1] == std::byte{0xde});
+        CHECK(buffer[4] == std::byte{0x00});
+        CHECK(buffer[5] == std::byte{0x90});
+        CHECK(buffer[35] == std::byte{0x90});
+        CHECK(buffer[36] == std::byte{0xdd});
+        CHECK(buffer[36 + 5] == std::byte{0xc0});
+        CHECK(buffer[buffer.size() - 2] == std::byte{0xc3});
+        CHECK(buffer.back() == std::byte{0xc0});
+
+        const auto value = msgpack::parse({buffer.data(), buffer.size() - 1});
+        CHECK(value.at(0).size() == 16);
+        CHECK(value.at(1).size() == 70000);
+        CHECK(value.at(2).get_bool());
+
+        std::vector<std::vector<std::vector<int>>> deep(3, {{1, 2}, {}, std::vector<int>(20, 7)});
+        CHECK(round_trip(deep) == deep);
+    }
+
+    SECTION("too long")
+    {
+        // Lengths are checked before anything is read from the data
+        const std::byte b{};
+        const auto huge = std::size_t{0xffffffff} + 1;
+        msgpack::writer writer;
+        writer.begin_array();
+        CHECK_THROWS_AS(writer.binary({&b, huge}), std::length_error);
+        CHECK_THROWS_AS(writer.string({"", huge}), std::length_error);
+        writer.binary({&b, 1});
+        writer.end_array();
+        CHECK(writer.buffer() == bytes({0x91, 0xc4, 0x01, 0x00}));
+    }
+
+    SECTION("skip null fields")
+    {
+        optional_test obj{1, std::nullopt};
+        CHECK(msgpack::dump(obj) == bytes({0x81, 0xa7, 'n', 'o', 'n', '_', 'o', 'p', 't', 0x01}));
+
+        msgpack::writer writer;
+        msgpack::dump_context ctx{writer, false};
+        msgpack::dump(obj, ctx);
+        CHECK(writer.buffer() == bytes({0x82, 0xa7, 'n', 'o', 'n', '_', 'o', 'p', 't', 0x01,
+                                        0xa3, 'o', 'p', 't', 0xc0}));
+    }
+
+    SECTION("round trip basic types")
+    {
+        CHECK(round_trip(13) == 13);
+        CHECK(round_trip(-13) == -13);
+        CHECK(round_trip(true));
+        CHECK(round_trip(3.25) == 3.25);
+        CHECK(round_trip(3.25f) == 3.25f);
+        CHECK(round_trip(std::string{"qwe"}) == "qwe");
+        CHECK(round_trip(std::string(300, 'q')) == std::string(300, 'q'));
+        CHECK(round_trip(colour_space::hls) == colour_space::hls);
+        const auto flags = kl::enum_set{device_type::cpu} | device_type::gpu;
+        CHECK(round_trip(flags) == flags);
+
+        const auto u = round_trip(unsigned_test{});
+        CHECK(u.u8 == unsigned_test{}.u8);
+        CHECK(u.u16 == unsigned_test{}.u16);
+        CHECK(u.u32 == unsigned_test{}.u32);
+        CHECK(u.u64 == unsigned_test{}.u64);
+
+        const auto s = round_trip(signed_test{});
+        CHECK(s.i8 == signed_test{}.i8);
+        CHECK(s.i16 == signed_test{}.i16);
+        CHECK(s.i32 == signed_test{}.i32);
+        CHECK(s.i64 == signed_test{}.i64);
+    }
+
+    SECTION("round trip reflectable")
+    {
+        test_t t;
+        t.hello = "msgpack";
+        t.n = 7;
+        t.a = std::vector<int>(20, 3);
+        t.space = colour_space::xyz;
+        t.map["3"] = colour_space::luv;
+        t.inner.r = -1;
+
+        const auto r = round_trip(t);
+        CHECK(r.hello == t.hello);
+        CHECK(r.t == t.t);
+        CHECK(r.f == t.f);
+        CHECK(r.n == t.n);
+        CHECK(r.i == t.i);
+        CHECK(r.pi == t.pi);
+        CHECK(r.a == t.a);
+        CHECK(r.ad == t.ad);
+        CHECK(r.space == t.space);
+        CHECK(r.tup == t.tup);
+        CHECK(r.map == t.map);
+        CHECK(r.inner.r == t.inner.r);
+        CHECK(r.inner.d == t.inner.d);
+
+        CHECK(round_trip(std::map<std::string, int>{{"a", -1}, {"b", 300}}) ==
+              std::map<std::string, int>{{"a", -1}, {"b", 300}});
+        CHECK(round_trip(std::optional<int>{}) == std::nullopt);
+        CHECK(round_trip(std::optional<int>{4}) == 4);
+    }
+
+    SECTION("deserialize")
+    {
+        const auto buffer = bytes({0x93, 0x01, 0xcb, 0x40, 0x00, 0, 0, 0, 0, 0, 0, 0xa1, 'x'});
+        const auto value = msgpack::parse(buffer);
+        REQUIRE(value.type() == msgpack::type::array);
+        CHECK(value.size() == 3);
+        CHECK(value.at(0).get_int64() == 1);
+        CHECK(value.at(1).get_double() == 2.0);
+        CHECK(value.at(2).get_string() == "x");
+        CHECK(value.at(3).is_nil());
+
+        // Integers are accepted for floating point
+        CHECK(msgpack::deserialize<double>(value.at(0)) == 1.0);
+        CHECK(msgpack::deserialize<std::string_view>(value.at(2)) == "x");
+
+        const auto tup = msgpack::deserialize<std::tuple<int, double, std::string>>(value);
+        CHECK(tup == std::make_tuple(1, 2.0, std::string{"x"}));
+
+        // Raw values can be kept and dumped back as they are
+        const auto raw = msgpack::deserialize<msgpack::value>(value.at(2));
+        CHECK(msgpack::dump(raw) == bytes({0xa1, 'x'}));
+        CHECK(msgpack::dump(value) == buffer);
+    }
+
+    SECTION("cursor")
+    {
+        const auto buffer = bytes({0x93, 0x92, 0x01, 0x02, 0xa1, 'x', 0xc3});
+        const auto value = msgpack::parse(buffer);
+
+        msgpack::value::cursor elements{value};
+        CHECK(elements.next().size() == 2);
+        CHECK(elements.next().get_string() == "x");
+        CHECK(elements.next().get_bool());
+        CHECK(elements.next().is_nil());
+        CHECK(elements.next().is_nil());
+
+        CHECK(msgpack::value::cursor{value.at(1)}.next().is_nil());
+    }
+
+    SECTION("fixed size sequences")
+    {
+        std::array<int, 1000> arr;
+        for (std::size_t i = 0; i < arr.size(); ++i)
+            arr[i] = static_cast<int>(i) * 3 - 500;
+        CHECK(round_trip(arr) == arr);
+
+        std::array<int, 1000> out{};
+        REQUIRE(msgpack::try_deserialize(out, msgpack::parse(msgpack::dump(arr))));
+        CHECK(out == arr);
+
+        const auto tup = std::make_tuple(std::string{"a"}, std::vector<int>{1, 2}, 3.5);
+        CHECK(round_trip(tup) == tup);
+        auto tup_out = decltype(tup){};
+        REQUIRE(msgpack::try_deserialize(tup_out, msgpack::parse(msgpack::dump(tup))));
+        CHECK(tup_out == tup);
+
+        // Structs can be read from sequences of their fields
+        const auto seq = msgpack::dump(std::make_tuple(5, 1.5));
+        auto obj = msgpack::deserialize<inner_t>(msgpack::parse(seq));
+        CHECK(obj.r == 5);
+        CHECK(obj.d == 1.5);
+        obj = {};
+        REQUIRE(msgpack::try_deserialize(obj, msgpack::parse(seq)));
+        CHECK(obj.r == 5);
+        CHECK(obj.d == 1.5);
+    }
+
+    SECTION("parse errors")
+    {
+        CHECK_THROWS_AS(msgpack::parse(bytes({})), serialization::parse_error);
+        CHECK_THROWS_WITH(msgpack::parse(bytes({0x92, 0x01})), "unexpected end of data");
+        CHECK_THROWS_WITH(msgpack::parse(bytes({0xa3, 'a'})), "unexpected end of data");
+        CHECK_THROWS_WITH(msgpack::parse(bytes({0xcd, 0x01})), "unexpected end of data");
+        CHECK_THROWS_WITH(msgpack::parse(bytes({0xdd, 0xff, 0xff, 0xff, 0xff})),
+                          "unexpected end of data");
+        CHECK_THROWS_WITH(msgpack::parse(bytes({0x91, 0xc1})), "invalid type marker at offset 1");
+        CHECK_THROWS_WITH(msgpack::parse(bytes({0x01, 0x02})),
+                          "unexpected data after the root value");
+    }
+
+    SECTION("deserialize errors")
+    {
+        const auto str = msgpack::dump("abc");
+        REQUIRE_THROWS_AS(msgpack::deserialize<int>(msgpack::parse(str)),
+                          serialization::deserialize_error);
+        CHECK_THROWS_WITH(msgpack::deserialize<int>(msgpack::parse(str)),
+                          "type must be an integer but is a string");
+        CHECK_THROWS_WITH(msgpack::deserialize<std::vector<int>>(msgpack::parse(str)),
+                          "type must be an array but is a string");
+
+        const auto big = msgpack::dump(300);
+        CHECK_THROWS_WITH(msgpack::deserialize<std::uint8_t>(msgpack::parse(big)),
+                          "value cannot be losslessly stored in the variable");
+        const auto neg = msgpack::dump(-1);
+        CHECK_THROWS_WITH(msgpack::deserialize<unsigned>(msgpack::parse(neg)),
+                          "value cannot be losslessly stored in the variable");
+
+        const auto obj = msgpack::dump(std::map<std::string, int>{{"d", 1}});
+        CHECK_THROWS_WITH(msgpack::deserialize<inner_t>(msgpack::parse(obj)),
+                          "type must be an integer but is a nil\n"
+                          "error when deserializing field r\n"
+                          "error when deserializing type " +
+                              kl::ctti::name<inner_t>());
+    }
+
+    SECTION("try_deserialize")
+    {
+        const auto buffer = msgpack::dump(std::vector<std::map<std::string, std::string>>{
+            {{"r", "1"}}, {{"r", "x"}, {"d", "2"}}});
+        std::vector<inner_t> out;
+        auto status = msgpack::try_deserialize(out, msgpack::parse(buffer));
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == "type must be an integer but is a string\n"
+                                  "error when deserializing field r\n"
+                                  "error when deserializing type " +
+                                      kl::ctti::name<inner_t>() +
+                                      "\nerror when deserializing element 0");
+        CHECK_THROWS_WITH(msgpack::deserialize(out, msgpack::parse(buffer)), status.message());
+
+        inner_t obj;
+        status = msgpack::try_deserialize(obj, msgpack::parse(msgpack::dump(inner_t{5, 1.0})));
+        REQUIRE(status);
+        CHECK(obj.r == 5);
+        CHECK(obj.d == 1.0);
+    }
+
+    SECTION("patch")
+    {
+        inner_t obj{1, 2.0};
+        const auto buffer = msgpack::dump(std::map<std::string, int>{{"r", 10}});
+        msgpack::patch(obj, msgpack::parse(buffer));
+        CHECK(obj.r == 10);
+        CHECK(obj.d == 2.0);
+    }
+}
@@ -4,6 +4,7 @@
 #include "kl/serialization.hpp"
 #include "kl/serialization_attributes.hpp"
 #include "kl/serialization_error.hpp"
+#include "kl/serialization_projection.hpp"
 #include "kl/yaml.hpp"
 
 #include "input/typedefs.hpp"
@@ -305,6 +306,29 @@ KL_REFLECT_STRUCT(custom_validated_serialization_record,
                           throw kl::serialization::deserialize_error{"value must be even"};
                   })))
 
+struct projected_base_record
+{
+    int id{};
+};
+
+KL_REFLECT_STRUCT(projected_base_record, id)
+
+struct projected_record : projected_base_record
+{
+    std::string name;
+    std::vector<int> payload{1, 2};
+    int count{};
+};
+
+KL_REFLECT_STRUCT_DERIVED(projected_record, projected_base_record,
+                          name,
+                          payload,
+                          (count, attr::rename("cnt"), attr::default_value(5)))
+
+using projected_record_header =
+    kl::serialization::projection<projected_record, &projected_record::id,
+                                  &projected_record::count>;
+
 struct generic_adl_value
 {
     int value;
@@ -382,6 +406,21 @@ using serialization_validator = kl::serialization::detail::serialize_field_names
 template <typename T>
 using deserialization_validator = kl::serialization::detail::deserialize_field_names_validator<T>;
 
+template <typename T>
+using field_name_table = kl::serialization::detail::field_name_table<T>;
+
+static_assert(field_name_table<renamed_serialization_record>::entries.size() == 5);
+static_assert(field_name_table<renamed_serialization_record>::find("id")->index == 0);
+static_assert(field_name_table<renamed_serialization_record>::find("api-token")->rank == 0);
+static_assert(field_name_table<renamed_serialization_record>::find("token")->index == 1);
+static_assert(field_name_table<renamed_serialization_record>::find("token")->rank == 2);
+static_assert(field_name_table<renamed_serialization_record>::find("request-timeout")->index == 2);
+static_assert(!field_name_table<renamed_serialization_record>::find("timeout"));
+static_assert(!field_name_table<renamed_serialization_record>::find(""));
+static_assert(field_name_table<directional_validation_record>::find("a")->index == 0);
+static_assert(field_name_table<directional_validation_record>::find("ro")->index == 3);
+static_assert(field_name_table<json_extra_fields_record>::entries.size() == 1);
+
 struct rename_collision_record
 {
     int a{};
@@ -1733,6 +1772,42 @@ TEST_CASE("serialization - field aliases", "[serialization]")
     }
 }
 
+TEST_CASE("serialization - canonical name wins over aliases", "[serialization]")
+{
+    SECTION("json")
+    {
+        auto json_out = kl::json::deserialize<serialization_record>(
+            R"({"i": 1, "numbers": [1], "values": [2], "vals": [3], "s": ""})"_json);
+        CHECK(json_out.values == std::vector<int>{2});
+
+        json_out = kl::json::deserialize<serialization_record>(
+            R"({"i": 1, "numbers": [1], "vals": [3], "s": ""})"_json);
+        CHECK(json_out.values == std::vector<int>{3});
+
+        // First of the duplicated keys wins
+        json_out = kl::json::deserialize<serialization_record>(
+            R"({"i": 1, "i": 2, "s": "", "values": []})"_json);
+        CHECK(json_out.i == 1);
+    }
+
+    SECTION("yaml")
+    {
+        YAML::Node node;
+        node["i"] = 1;
+        node["s"] = "";
+        node["numbers"].push_back(1);
+        node["values"].push_back(2);
+        node["vals"].push_back(3);
+
+        auto yaml_out = kl::yaml::deserialize<serialization_record>(node);
+        CHECK(yaml_out.values == std::vector<int>{2});
+
+        node.remove("values");
+        yaml_out = kl::yaml::deserialize<serialization_record>(node);
+        CHECK(yaml_out.values == std::vector<int>{3});
+    }
+}
+
 TEST_CASE("serialization - renamed fields", "[serialization]")
 {
     renamed_serialization_record record{1, 2, 3};
@@ -1890,3 +1965,62 @@ TEST_CASE("serialization - chrono duration serializer works with json and yaml",
     CHECK(kl::json::dump(dumped) == R"({"t":2,"sec":10,"secs":[6,12]})");
     CHECK(kl::yaml::dump(dumped) == "t: 2\nsec: 10\nsecs:\n  - 6\n  - 12");
 }
+
+TEST_CASE("serialization - projection", "[serialization]")
+{
+    static_assert(kl::ctti::num_fields<projected_record_header>() == 2);
+
+    SECTION("json")
+    {
+        // Unselected members are never looked at, not even to type check them
+        rapidjson::Document doc = R"({
+            "id": 3,
+            "name": 123,
+            "payload": [1, "two", {"three": 3}],
+            "cnt": 10
+        })"_json;
+
+        auto header = kl::json::deserialize<projected_record_header>(doc);
+        CHECK(header->id == 3);
+        CHECK(header->count == 10);
+        CHECK(header->name.empty());
+        CHECK(header->payload == std::vector<int>{1, 2});
+
+        const auto text = kl::json::dump(doc);
+        header = kl::json::load<projected_record_header>(text);
+        CHECK(header->id == 3);
+        CHECK(header->count == 10);
+        CHECK(header->payload == std::vector<int>{1, 2});
+
+        // Attributes of selected fields still apply
+        header = kl::json::load<projected_record_header>(R"({"id": 4})");
+        CHECK(header->id == 4);
+        CHECK(header->count == 5);
+
+        CHECK_THROWS_WITH(kl::json::load<projected_record_header>(R"({"cnt": 1})"),
+                          "type must be an integral but is a Null\n"
+                          "error when deserializing field id\n"
+                          "error when deserializing type " +
+                              kl::ctti::name<projected_record_header>());
+
+        CHECK(kl::json::dump(header) == R"({"id":4,"cnt":5})");
+    }
+
+    SECTION("yaml")
+    {
+        auto yaml_value = R"(
+id: 3
+name: [x]
+payload: {a: b}
+cnt: 10
+)"_yaml;
+
+        auto header = kl::yaml::deserialize<projected_record_header>(yaml_value);
+        CHECK(header->id == 3);
+        CHECK(header->count == 10);
+        CHECK(header->name.empty());
+        CHECK(header->payload == std::vector<int>{1, 2});
+
+        CHECK(kl::yaml::dump(header) == "id: 3\ncnt: 10");
+    }
+}
@@ -1310,3 +1310,94 @@ array:
                         "yaml-cpp: error at line 6, column 5: bad conversion\n"
                         "error when deserializing element 2");
 }
+
+TEST_CASE("yaml::try_deserialize", "[yaml][serialization]")
+{
+    using namespace kl;
+
+    // Status message must match what the throwing path reports
+    auto thrown_message = [](auto& out, const YAML::Node& y) -> std::string {
+        try
+        {
+            yaml::deserialize(out, y);
+        }
+        catch (const serialization::deserialize_error& ex)
+        {
+            return ex.what();
+        }
+        return {};
+    };
+
+    SECTION("success")
+    {
+        inner_t obj;
+        auto status = yaml::try_deserialize(obj, "d: 1.0\nr: 2"_yaml);
+        REQUIRE(status);
+        CHECK_FALSE(status.failed());
+        CHECK(status.message().empty());
+        CHECK(obj.r == 2);
+        CHECK(obj.d == 1.0);
+    }
+
+    SECTION("missing field")
+    {
+        const auto y = "d: 1.0"_yaml;
+        inner_t obj;
+        auto status = yaml::try_deserialize(obj, y);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == "type must be a scalar but is a Null\n"
+                                  "error when deserializing field r\n"
+                                  "error when deserializing type " +
+                                      kl::ctti::name<inner_t>());
+        CHECK(status.message() == thrown_message(obj, y));
+        CHECK_THROWS_WITH(status.raise(), status.message());
+    }
+
+    SECTION("bad conversion in nested sequence")
+    {
+        const auto y = "[{r: 1, d: 2.0}, {r: abc, d: 3.0}]"_yaml;
+        std::vector<inner_t> vec;
+        auto status = yaml::try_deserialize(vec, y);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == "yaml-cpp: error at line 1, column 22: bad conversion\n"
+                                  "error when deserializing field r\n"
+                                  "error when deserializing type " +
+                                      kl::ctti::name<inner_t>() +
+                                      "\nerror when deserializing element 1");
+        CHECK(status.message() == thrown_message(vec, y));
+    }
+
+    SECTION("map and tuple")
+    {
+        const auto y = "{a: [1, x], b: [2, y]}"_yaml;
+        std::map<std::string, std::tuple<int, std::string>> map;
+        REQUIRE(yaml::try_deserialize(map, y));
+        CHECK(map.size() == 2);
+
+        const auto bad = "{a: [1, x], b: [y, 2]}"_yaml;
+        auto status = yaml::try_deserialize(map, bad);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == thrown_message(map, bad));
+    }
+
+    SECTION("manually deserialized type falls back to exceptions")
+    {
+        const auto y = "{a: asd, b: 3, c: 3, d: [1]}"_yaml;
+        zxc z;
+        auto status = yaml::try_deserialize(z, y);
+        REQUIRE_FALSE(status);
+        CHECK(status.message() == thrown_message(z, y));
+    }
+
+    SECTION("reuse status")
+    {
+        yaml::deserialize_context ctx;
+        serialization::deserialize_status status;
+        int i = 0;
+        CHECK_FALSE(yaml::try_deserialize(i, "[1]"_yaml, ctx, status));
+        CHECK(status.message() == "type must be a scalar but is a Sequence");
+        CHECK(yaml::try_deserialize(i, "7"_yaml, ctx, status));
+        CHECK(status);
+        CHECK(i == 7);
+    }
+}